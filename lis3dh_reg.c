@@ -18,6 +18,14 @@
 
 #include "lis3dh_reg.h"
 
+#if defined(LIS3DH_BUS_READ) != defined(LIS3DH_BUS_WRITE)
+#error "LIS3DH_BUS_READ and LIS3DH_BUS_WRITE must be defined together"
+#endif /* LIS3DH_BUS_READ / LIS3DH_BUS_WRITE */
+
+#ifdef LIS3DH_BUS_INCLUDE
+#include LIS3DH_BUS_INCLUDE
+#endif /* LIS3DH_BUS_INCLUDE */
+
 /**
   * @defgroup  LIS3DH
   * @brief     This file provides a set of functions needed to drive the
@@ -35,6 +43,171 @@
   *
   */
 
+/**
+  * @brief  Check if a register belongs to the device configuration, i.e.
+  *         it is read / write in the CTRL_REG0 .. ACT_DUR range.
+  *         Data, status and source registers change on their own (or
+  *         are cleared on read) and REFERENCE resets the high-pass
+  *         filter when read, so they are left out.
+  *
+  * @param  reg      register address
+  * @retval          PROPERTY_ENABLE if configuration register,
+  *                  PROPERTY_DISABLE if not
+  *
+  */
+static uint8_t lis3dh_is_config_reg(uint8_t reg)
+{
+  uint8_t ret;
+
+  if ((reg < LIS3DH_CTRL_REG0) || (reg > LIS3DH_ACT_DUR))
+  {
+    return PROPERTY_DISABLE;
+  }
+
+  switch (reg)
+  {
+    case LIS3DH_REFERENCE:
+    case LIS3DH_STATUS_REG:
+    case LIS3DH_OUT_X_L:
+    case LIS3DH_OUT_X_H:
+    case LIS3DH_OUT_Y_L:
+    case LIS3DH_OUT_Y_H:
+    case LIS3DH_OUT_Z_L:
+    case LIS3DH_OUT_Z_H:
+    case LIS3DH_FIFO_SRC_REG:
+    case LIS3DH_INT1_SRC:
+    case LIS3DH_INT2_SRC:
+    case LIS3DH_CLICK_SRC:
+      ret = PROPERTY_DISABLE;
+      break;
+
+    default:
+      ret = PROPERTY_ENABLE;
+      break;
+  }
+
+  return ret;
+}
+
+#ifdef LIS3DH_SHADOW_CACHE
+
+/**
+  * @brief  Serve a register read from the shadow cache.
+  *         Only reads made entirely of cacheable registers are
+  *         accounted as hit or miss.
+  *
+  * @param  ctx   read / write interface definitions(ptr)
+  * @param  reg   first register to read
+  * @param  data  pointer to buffer that store the data read(ptr)
+  * @param  len   number of consecutive register to read
+  * @retval       PROPERTY_ENABLE if data has been filled from cache
+  *
+  */
+static uint8_t lis3dh_cache_lookup(const stmdev_ctx_t *ctx, uint8_t reg,
+                                   uint8_t *data, uint16_t len)
+{
+  lis3dh_cache_t *cache = (lis3dh_cache_t *)ctx->priv_data;
+  uint64_t mask = 0;
+  uint16_t i;
+  uint8_t off;
+
+  if ((cache == NULL) || (len == 0U))
+  {
+    return PROPERTY_DISABLE;
+  }
+
+  for (i = 0; i < len; i++)
+  {
+    if (lis3dh_is_config_reg((uint8_t)(reg + i)) == PROPERTY_DISABLE)
+    {
+      return PROPERTY_DISABLE;
+    }
+
+    off = (uint8_t)((uint8_t)(reg + i) - LIS3DH_CACHE_FIRST);
+    mask |= (uint64_t)1U << off;
+  }
+
+  if ((cache->valid & mask) != mask)
+  {
+    cache->miss++;
+    return PROPERTY_DISABLE;
+  }
+
+  off = (uint8_t)(reg - LIS3DH_CACHE_FIRST);
+  for (i = 0; i < len; i++)
+  {
+    data[i] = cache->reg[off + i];
+  }
+  cache->hit++;
+
+  return PROPERTY_ENABLE;
+}
+
+/**
+  * @brief  Refresh the shadow cache after a successful bus transaction.
+  *         Setting BOOT reloads the whole register set, so the cache is
+  *         dropped; a CTRL_REG5 read with BOOT still pending is not kept.
+  *         The address does not always count up: with FIFO enabled a
+  *         burst rolls back from OUT_Z_H to OUT_X_L, so nothing past
+  *         OUT_Z_H is cached.
+  *
+  * @param  ctx    read / write interface definitions(ptr)
+  * @param  reg    first register transferred
+  * @param  data   data transferred(ptr)
+  * @param  len    number of consecutive register transferred
+  * @param  write  PROPERTY_ENABLE if data has been written to the device
+  *
+  */
+static void lis3dh_cache_update(const stmdev_ctx_t *ctx, uint8_t reg,
+                                const uint8_t *data, uint16_t len,
+                                uint8_t write)
+{
+  lis3dh_cache_t *cache = (lis3dh_cache_t *)ctx->priv_data;
+  uint16_t i;
+  uint8_t addr;
+  uint8_t off;
+  uint8_t boot = PROPERTY_DISABLE;
+
+  if (cache == NULL)
+  {
+    return;
+  }
+
+  for (i = 0; i < len; i++)
+  {
+    addr = (uint8_t)(reg + i);
+
+    if (addr == LIS3DH_OUT_Z_H)
+    {
+      break;
+    }
+
+    if (lis3dh_is_config_reg(addr) == PROPERTY_DISABLE)
+    {
+      continue;
+    }
+
+    off = (uint8_t)(addr - LIS3DH_CACHE_FIRST);
+    if ((addr == LIS3DH_CTRL_REG5) && ((data[i] & 0x80U) != 0U))
+    {
+      boot = PROPERTY_ENABLE;
+      cache->valid &= ~((uint64_t)1U << off);
+    }
+    else
+    {
+      cache->reg[off] = data[i];
+      cache->valid |= (uint64_t)1U << off;
+    }
+  }
+
+  if ((boot == PROPERTY_ENABLE) && (write == PROPERTY_ENABLE))
+  {
+    cache->valid = 0;
+  }
+}
+
+#endif /* LIS3DH_SHADOW_CACHE */
+
 /**
   * @brief  Read generic device register
   *
@@ -45,8 +218,13 @@
   * @retval          interface status (MANDATORY: return 0 -> no Error)
   *
   */
+#ifdef LIS3DH_BUS_READ
+int32_t lis3dh_read_reg(const stmdev_ctx_t *ctx, uint8_t reg, uint8_t *data,
+                        uint16_t len)
+#else
 int32_t __weak lis3dh_read_reg(const stmdev_ctx_t *ctx, uint8_t reg, uint8_t *data,
                                uint16_t len)
+#endif /* LIS3DH_BUS_READ */
 {
   int32_t ret;
 
@@ -55,7 +233,25 @@ int32_t __weak lis3dh_read_reg(const stmdev_ctx_t *ctx, uint8_t reg, uint8_t *da
     return -1;
   }
 
+#ifdef LIS3DH_SHADOW_CACHE
+  if (lis3dh_cache_lookup(ctx, reg, data, len) == PROPERTY_ENABLE)
+  {
+    return 0;
+  }
+#endif /* LIS3DH_SHADOW_CACHE */
+
+#ifdef LIS3DH_BUS_READ
+  ret = LIS3DH_BUS_READ(ctx->handle, reg, data, len);
+#else
   ret = ctx->read_reg(ctx->handle, reg, data, len);
+#endif /* LIS3DH_BUS_READ */
+
+#ifdef LIS3DH_SHADOW_CACHE
+  if (ret == 0)
+  {
+    lis3dh_cache_update(ctx, reg, data, len, PROPERTY_DISABLE);
+  }
+#endif /* LIS3DH_SHADOW_CACHE */
 
   return ret;
 }
@@ -70,9 +266,15 @@ int32_t __weak lis3dh_read_reg(const stmdev_ctx_t *ctx, uint8_t reg, uint8_t *da
   * @retval          interface status (MANDATORY: return 0 -> no Error)
   *
   */
+#ifdef LIS3DH_BUS_WRITE
+int32_t lis3dh_write_reg(const stmdev_ctx_t *ctx, uint8_t reg,
+                         uint8_t *data,
+                         uint16_t len)
+#else
 int32_t __weak lis3dh_write_reg(const stmdev_ctx_t *ctx, uint8_t reg,
                                 uint8_t *data,
                                 uint16_t len)
+#endif /* LIS3DH_BUS_WRITE */
 {
   int32_t ret;
 
@@ -81,7 +283,185 @@ int32_t __weak lis3dh_write_reg(const stmdev_ctx_t *ctx, uint8_t reg,
     return -1;
   }
 
+#ifdef LIS3DH_BUS_WRITE
+  ret = LIS3DH_BUS_WRITE(ctx->handle, reg, data, len);
+#else
   ret = ctx->write_reg(ctx->handle, reg, data, len);
+#endif /* LIS3DH_BUS_WRITE */
+
+#ifdef LIS3DH_SHADOW_CACHE
+  if (ret == 0)
+  {
+    lis3dh_cache_update(ctx, reg, data, len, PROPERTY_ENABLE);
+  }
+#endif /* LIS3DH_SHADOW_CACHE */
+
+  return ret;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup  LIS3DH_Field_engine
+  * @brief     Generic access to register bit-fields, described by a
+  *            table (address, position, width) instead of one
+  *            read / modify / write body per API.
+  * @{
+  *
+  */
+
+typedef enum
+{
+  LIS3DH_FIELD_TDA,
+  LIS3DH_FIELD_TOR,
+  LIS3DH_FIELD_SDO_PU_DISC,
+  LIS3DH_FIELD_ODR,
+  LIS3DH_FIELD_HP,
+  LIS3DH_FIELD_FDS,
+  LIS3DH_FIELD_HPCF,
+  LIS3DH_FIELD_HPM,
+  LIS3DH_FIELD_SIM,
+  LIS3DH_FIELD_ST,
+  LIS3DH_FIELD_FS,
+  LIS3DH_FIELD_BLE,
+  LIS3DH_FIELD_BDU,
+  LIS3DH_FIELD_D4D_INT2,
+  LIS3DH_FIELD_LIR_INT2,
+  LIS3DH_FIELD_D4D_INT1,
+  LIS3DH_FIELD_LIR_INT1,
+  LIS3DH_FIELD_FIFO_EN,
+  LIS3DH_FIELD_BOOT,
+  LIS3DH_FIELD_ZYXDA,
+  LIS3DH_FIELD_ZYXOR,
+  LIS3DH_FIELD_FTH,
+  LIS3DH_FIELD_TR,
+  LIS3DH_FIELD_FM,
+  LIS3DH_FIELD_FSS,
+  LIS3DH_FIELD_EMPTY,
+  LIS3DH_FIELD_OVRN_FIFO,
+  LIS3DH_FIELD_WTM,
+  LIS3DH_FIELD_INT1_THS,
+  LIS3DH_FIELD_INT1_D,
+  LIS3DH_FIELD_INT2_THS,
+  LIS3DH_FIELD_INT2_D,
+  LIS3DH_FIELD_CLICK_THS,
+  LIS3DH_FIELD_LIR_CLICK,
+  LIS3DH_FIELD_TLI,
+  LIS3DH_FIELD_TLA,
+  LIS3DH_FIELD_TW,
+  LIS3DH_FIELD_ACTH,
+  LIS3DH_FIELD_ACTD,
+} lis3dh_field_id_t;
+
+typedef struct
+{
+  uint8_t reg;
+  uint8_t shift;
+  uint8_t width;
+} lis3dh_field_t;
+
+static const lis3dh_field_t lis3dh_field[] =
+{
+  [LIS3DH_FIELD_TDA]         = { LIS3DH_STATUS_REG_AUX, 2, 1 },
+  [LIS3DH_FIELD_TOR]         = { LIS3DH_STATUS_REG_AUX, 6, 1 },
+  [LIS3DH_FIELD_SDO_PU_DISC] = { LIS3DH_CTRL_REG0,      7, 1 },
+  [LIS3DH_FIELD_ODR]         = { LIS3DH_CTRL_REG1,      4, 4 },
+  [LIS3DH_FIELD_HP]          = { LIS3DH_CTRL_REG2,      0, 3 },
+  [LIS3DH_FIELD_FDS]         = { LIS3DH_CTRL_REG2,      3, 1 },
+  [LIS3DH_FIELD_HPCF]        = { LIS3DH_CTRL_REG2,      4, 2 },
+  [LIS3DH_FIELD_HPM]         = { LIS3DH_CTRL_REG2,      6, 2 },
+  [LIS3DH_FIELD_SIM]         = { LIS3DH_CTRL_REG4,      0, 1 },
+  [LIS3DH_FIELD_ST]          = { LIS3DH_CTRL_REG4,      1, 2 },
+  [LIS3DH_FIELD_FS]          = { LIS3DH_CTRL_REG4,      4, 2 },
+  [LIS3DH_FIELD_BLE]         = { LIS3DH_CTRL_REG4,      6, 1 },
+  [LIS3DH_FIELD_BDU]         = { LIS3DH_CTRL_REG4,      7, 1 },
+  [LIS3DH_FIELD_D4D_INT2]    = { LIS3DH_CTRL_REG5,      0, 1 },
+  [LIS3DH_FIELD_LIR_INT2]    = { LIS3DH_CTRL_REG5,      1, 1 },
+  [LIS3DH_FIELD_D4D_INT1]    = { LIS3DH_CTRL_REG5,      2, 1 },
+  [LIS3DH_FIELD_LIR_INT1]    = { LIS3DH_CTRL_REG5,      3, 1 },
+  [LIS3DH_FIELD_FIFO_EN]     = { LIS3DH_CTRL_REG5,      6, 1 },
+  [LIS3DH_FIELD_BOOT]        = { LIS3DH_CTRL_REG5,      7, 1 },
+  [LIS3DH_FIELD_ZYXDA]       = { LIS3DH_STATUS_REG,     3, 1 },
+  [LIS3DH_FIELD_ZYXOR]       = { LIS3DH_STATUS_REG,     7, 1 },
+  [LIS3DH_FIELD_FTH]         = { LIS3DH_FIFO_CTRL_REG,  0, 5 },
+  [LIS3DH_FIELD_TR]          = { LIS3DH_FIFO_CTRL_REG,  5, 1 },
+  [LIS3DH_FIELD_FM]          = { LIS3DH_FIFO_CTRL_REG,  6, 2 },
+  [LIS3DH_FIELD_FSS]         = { LIS3DH_FIFO_SRC_REG,   0, 5 },
+  [LIS3DH_FIELD_EMPTY]       = { LIS3DH_FIFO_SRC_REG,   5, 1 },
+  [LIS3DH_FIELD_OVRN_FIFO]   = { LIS3DH_FIFO_SRC_REG,   6, 1 },
+  [LIS3DH_FIELD_WTM]         = { LIS3DH_FIFO_SRC_REG,   7, 1 },
+  [LIS3DH_FIELD_INT1_THS]    = { LIS3DH_INT1_THS,       0, 7 },
+  [LIS3DH_FIELD_INT1_D]      = { LIS3DH_INT1_DURATION,  0, 7 },
+  [LIS3DH_FIELD_INT2_THS]    = { LIS3DH_INT2_THS,       0, 7 },
+  [LIS3DH_FIELD_INT2_D]      = { LIS3DH_INT2_DURATION,  0, 7 },
+  [LIS3DH_FIELD_CLICK_THS]   = { LIS3DH_CLICK_THS,      0, 7 },
+  [LIS3DH_FIELD_LIR_CLICK]   = { LIS3DH_CLICK_THS,      7, 1 },
+  [LIS3DH_FIELD_TLI]         = { LIS3DH_TIME_LIMIT,     0, 7 },
+  [LIS3DH_FIELD_TLA]         = { LIS3DH_TIME_LATENCY,   0, 8 },
+  [LIS3DH_FIELD_TW]          = { LIS3DH_TIME_WINDOW,    0, 8 },
+  [LIS3DH_FIELD_ACTH]        = { LIS3DH_ACT_THS,        0, 7 },
+  [LIS3DH_FIELD_ACTD]        = { LIS3DH_ACT_DUR,        0, 8 },
+};
+
+/**
+  * @brief  Write a register bit-field, leaving the other bits unchanged.
+  *         Fields as wide as the register are written without reading
+  *         the register first.
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  id       field descriptor index
+  * @param  val      new field value (extra bits are discarded)
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+static int32_t lis3dh_field_set(const stmdev_ctx_t *ctx,
+                                lis3dh_field_id_t id, uint8_t val)
+{
+  const lis3dh_field_t *field = &lis3dh_field[id];
+  uint8_t mask = (uint8_t)(((1U << field->width) - 1U) << field->shift);
+  uint8_t reg = 0;
+  int32_t ret = 0;
+
+  if (mask != 0xFFU)
+  {
+    ret = lis3dh_read_reg(ctx, field->reg, &reg, 1);
+  }
+
+  if (ret == 0)
+  {
+    reg = (uint8_t)((reg & (uint8_t)~mask) |
+                    ((uint8_t)(val << field->shift) & mask));
+    ret = lis3dh_write_reg(ctx, field->reg, &reg, 1);
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Read a register bit-field.
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  id       field descriptor index
+  * @param  val      field value
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+static int32_t lis3dh_field_get(const stmdev_ctx_t *ctx,
+                                lis3dh_field_id_t id, uint8_t *val)
+{
+  const lis3dh_field_t *field = &lis3dh_field[id];
+  uint8_t reg;
+  int32_t ret;
+
+  ret = lis3dh_read_reg(ctx, field->reg, &reg, 1);
+
+  if (ret != 0) { return ret; }
+
+  *val = (uint8_t)((uint32_t)reg >> field->shift) &
+         (uint8_t)((1U << field->width) - 1U);
 
   return ret;
 }
@@ -173,6 +553,134 @@ float_t lis3dh_from_lsb_lp_to_celsius(int16_t lsb)
   return (((float_t)lsb / 256.0f) * 1.0f) + 25.0f;
 }
 
+/* mg/LSB of the left-justified raw data, [lis3dh_op_md_t][lis3dh_fs_t] */
+static const float_t lis3dh_mg_per_lsb[3][4] =
+{
+  { 1.0f / 16.0f,   2.0f / 16.0f,   4.0f / 16.0f,  12.0f / 16.0f },
+  { 4.0f / 64.0f,   8.0f / 64.0f,  16.0f / 64.0f,  48.0f / 64.0f },
+  { 16.0f / 256.0f, 32.0f / 256.0f, 64.0f / 256.0f, 192.0f / 256.0f },
+};
+
+/* ug/LSB times 2 of the left-justified raw data, same layout as above */
+static const int32_t lis3dh_ug_x2_per_lsb[3][4] =
+{
+  { 125, 250, 500, 1500 },
+  { 125, 250, 500, 1500 },
+  { 125, 250, 500, 1500 },
+};
+
+/**
+  * @brief  Check operating mode and full scale used to index the
+  *         sensitivity tables.
+  *
+  * @param  mode     operating mode
+  * @param  fs       full scale
+  * @retval          0 if valid, -1 if not
+  *
+  */
+static int32_t lis3dh_sensitivity_check(lis3dh_op_md_t mode, lis3dh_fs_t fs)
+{
+  if (((uint32_t)mode > (uint32_t)LIS3DH_LP_8bit) ||
+      ((uint32_t)fs > (uint32_t)LIS3DH_16g))
+  {
+    return -1;
+  }
+
+  return 0;
+}
+
+/**
+  * @brief  Convert a block of raw samples into mg.
+  *         Same result, bit by bit, as the lis3dh_from_fs*_to_mg
+  *         function selected by mode and fs: dividing by a power of two
+  *         is exact, so a single multiply by the folded sensitivity
+  *         rounds the same way. The loop body has no branches and is
+  *         suitable for compiler auto-vectorization.
+  *
+  * @param  mode     operating mode the samples were acquired with
+  * @param  fs       full scale the samples were acquired with
+  * @param  in       raw samples (n entries)
+  * @param  out      converted samples in mg (n entries)
+  * @param  n        number of samples
+  * @retval          0 on success, -1 if mode or fs are not valid
+  *
+  */
+int32_t lis3dh_from_lsb_to_mg_batch(lis3dh_op_md_t mode, lis3dh_fs_t fs,
+                                    const int16_t *in, float_t *out,
+                                    size_t n)
+{
+  float_t sens;
+  size_t i;
+
+  if (lis3dh_sensitivity_check(mode, fs) != 0)
+  {
+    return -1;
+  }
+
+  sens = lis3dh_mg_per_lsb[mode][fs];
+
+  for (i = 0; i < n; i++)
+  {
+    out[i] = (float_t)in[i] * sens;
+  }
+
+  return 0;
+}
+
+/**
+  * @brief  Convert a raw sample into micro-g with integer arithmetic only,
+  *         for targets without FPU.
+  *
+  * @param  mode     operating mode the sample was acquired with
+  * @param  fs       full scale the sample was acquired with
+  * @param  lsb      raw sample
+  * @param  ug       converted sample in micro-g
+  * @retval          0 on success, -1 if mode or fs are not valid
+  *
+  */
+int32_t lis3dh_from_lsb_to_ug(lis3dh_op_md_t mode, lis3dh_fs_t fs,
+                              int16_t lsb, int32_t *ug)
+{
+  return lis3dh_from_lsb_to_ug_batch(mode, fs, &lsb, ug, 1);
+}
+
+/**
+  * @brief  Convert a block of raw samples into micro-g with integer
+  *         arithmetic only, for targets without FPU.
+  *         Output data are left-justified, so the unused low bits of a
+  *         real sample are zero and the result is exact; an odd raw
+  *         value is truncated toward zero (error below 1 ug).
+  *
+  * @param  mode     operating mode the samples were acquired with
+  * @param  fs       full scale the samples were acquired with
+  * @param  in       raw samples (n entries)
+  * @param  out      converted samples in micro-g (n entries)
+  * @param  n        number of samples
+  * @retval          0 on success, -1 if mode or fs are not valid
+  *
+  */
+int32_t lis3dh_from_lsb_to_ug_batch(lis3dh_op_md_t mode, lis3dh_fs_t fs,
+                                    const int16_t *in, int32_t *out,
+                                    size_t n)
+{
+  int32_t sens;
+  size_t i;
+
+  if (lis3dh_sensitivity_check(mode, fs) != 0)
+  {
+    return -1;
+  }
+
+  sens = lis3dh_ug_x2_per_lsb[mode][fs];
+
+  for (i = 0; i < n; i++)
+  {
+    out[i] = ((int32_t)in[i] * sens) / 2;
+  }
+
+  return 0;
+}
+
 /**
   * @}
   *
@@ -211,15 +719,9 @@ int32_t lis3dh_temp_status_reg_get(const stmdev_ctx_t *ctx, uint8_t *buff)
   */
 int32_t lis3dh_temp_data_ready_get(const stmdev_ctx_t *ctx, uint8_t *val)
 {
-  lis3dh_status_reg_aux_t status_reg_aux;
   int32_t ret;
 
-  ret = lis3dh_read_reg(ctx, LIS3DH_STATUS_REG_AUX,
-                        (uint8_t *)&status_reg_aux, 1);
-
-  if (ret != 0) { return ret; }
-
-  *val = status_reg_aux._3da;
+  ret = lis3dh_field_get(ctx, LIS3DH_FIELD_TDA, val);
 
   return ret;
 }
@@ -233,15 +735,9 @@ int32_t lis3dh_temp_data_ready_get(const stmdev_ctx_t *ctx, uint8_t *val)
   */
 int32_t lis3dh_temp_data_ovr_get(const stmdev_ctx_t *ctx, uint8_t *val)
 {
-  lis3dh_status_reg_aux_t status_reg_aux;
   int32_t ret;
 
-  ret = lis3dh_read_reg(ctx, LIS3DH_STATUS_REG_AUX,
-                        (uint8_t *)&status_reg_aux, 1);
-
-  if (ret != 0) { return ret; }
-
-  *val = status_reg_aux._3or;
+  ret = lis3dh_field_get(ctx, LIS3DH_FIELD_TOR, val);
 
   return ret;
 }
@@ -479,16 +975,9 @@ int32_t lis3dh_operating_mode_get(const stmdev_ctx_t *ctx,
   */
 int32_t lis3dh_data_rate_set(const stmdev_ctx_t *ctx, lis3dh_odr_t val)
 {
-  lis3dh_ctrl_reg1_t ctrl_reg1;
   int32_t ret;
 
-  ret = lis3dh_read_reg(ctx, LIS3DH_CTRL_REG1, (uint8_t *)&ctrl_reg1, 1);
-
-  if (ret == 0)
-  {
-    ctrl_reg1.odr = (uint8_t)val & 0x0FU;
-    ret = lis3dh_write_reg(ctx, LIS3DH_CTRL_REG1, (uint8_t *)&ctrl_reg1, 1);
-  }
+  ret = lis3dh_field_set(ctx, LIS3DH_FIELD_ODR, (uint8_t)val);
 
   return ret;
 }
@@ -572,16 +1061,9 @@ int32_t lis3dh_data_rate_get(const stmdev_ctx_t *ctx, lis3dh_odr_t *val)
 int32_t lis3dh_high_pass_on_outputs_set(const stmdev_ctx_t *ctx,
                                         uint8_t val)
 {
-  lis3dh_ctrl_reg2_t ctrl_reg2;
   int32_t ret;
 
-  ret = lis3dh_read_reg(ctx, LIS3DH_CTRL_REG2, (uint8_t *)&ctrl_reg2, 1);
-
-  if (ret == 0)
-  {
-    ctrl_reg2.fds = val & 0x01U;
-    ret = lis3dh_write_reg(ctx, LIS3DH_CTRL_REG2, (uint8_t *)&ctrl_reg2, 1);
-  }
+  ret = lis3dh_field_set(ctx, LIS3DH_FIELD_FDS, val);
 
   return ret;
 }
@@ -598,14 +1080,9 @@ int32_t lis3dh_high_pass_on_outputs_set(const stmdev_ctx_t *ctx,
 int32_t lis3dh_high_pass_on_outputs_get(const stmdev_ctx_t *ctx,
                                         uint8_t *val)
 {
-  lis3dh_ctrl_reg2_t ctrl_reg2;
   int32_t ret;
 
-  ret = lis3dh_read_reg(ctx, LIS3DH_CTRL_REG2, (uint8_t *)&ctrl_reg2, 1);
-
-  if (ret != 0) { return ret; }
-
-  *val = (uint8_t)ctrl_reg2.fds;
+  ret = lis3dh_field_get(ctx, LIS3DH_FIELD_FDS, val);
 
   return ret;
 }
@@ -627,16 +1104,9 @@ int32_t lis3dh_high_pass_on_outputs_get(const stmdev_ctx_t *ctx,
 int32_t lis3dh_high_pass_bandwidth_set(const stmdev_ctx_t *ctx,
                                        lis3dh_hpcf_t val)
 {
-  lis3dh_ctrl_reg2_t ctrl_reg2;
   int32_t ret;
 
-  ret = lis3dh_read_reg(ctx, LIS3DH_CTRL_REG2, (uint8_t *)&ctrl_reg2, 1);
-
-  if (ret == 0)
-  {
-    ctrl_reg2.hpcf = (uint8_t)val & 0x03U;
-    ret = lis3dh_write_reg(ctx, LIS3DH_CTRL_REG2, (uint8_t *)&ctrl_reg2, 1);
-  }
+  ret = lis3dh_field_set(ctx, LIS3DH_FIELD_HPCF, (uint8_t)val);
 
   return ret;
 }
@@ -701,16 +1171,9 @@ int32_t lis3dh_high_pass_bandwidth_get(const stmdev_ctx_t *ctx,
   */
 int32_t lis3dh_high_pass_mode_set(const stmdev_ctx_t *ctx, lis3dh_hpm_t val)
 {
-  lis3dh_ctrl_reg2_t ctrl_reg2;
   int32_t ret;
 
-  ret = lis3dh_read_reg(ctx, LIS3DH_CTRL_REG2, (uint8_t *)&ctrl_reg2, 1);
-
-  if (ret == 0)
-  {
-    ctrl_reg2.hpm = (uint8_t)val & 0x03U;
-    ret = lis3dh_write_reg(ctx, LIS3DH_CTRL_REG2, (uint8_t *)&ctrl_reg2, 1);
-  }
+  ret = lis3dh_field_set(ctx, LIS3DH_FIELD_HPM, (uint8_t)val);
 
   return ret;
 }
@@ -769,16 +1232,9 @@ int32_t lis3dh_high_pass_mode_get(const stmdev_ctx_t *ctx,
   */
 int32_t lis3dh_full_scale_set(const stmdev_ctx_t *ctx, lis3dh_fs_t val)
 {
-  lis3dh_ctrl_reg4_t ctrl_reg4;
   int32_t ret;
 
-  ret = lis3dh_read_reg(ctx, LIS3DH_CTRL_REG4, (uint8_t *)&ctrl_reg4, 1);
-
-  if (ret == 0)
-  {
-    ctrl_reg4.fs = (uint8_t)val & 0x03U;
-    ret = lis3dh_write_reg(ctx, LIS3DH_CTRL_REG4, (uint8_t *)&ctrl_reg4, 1);
-  }
+  ret = lis3dh_field_set(ctx, LIS3DH_FIELD_FS, (uint8_t)val);
 
   return ret;
 }
@@ -836,16 +1292,9 @@ int32_t lis3dh_full_scale_get(const stmdev_ctx_t *ctx, lis3dh_fs_t *val)
   */
 int32_t lis3dh_block_data_update_set(const stmdev_ctx_t *ctx, uint8_t val)
 {
-  lis3dh_ctrl_reg4_t ctrl_reg4;
   int32_t ret;
 
-  ret = lis3dh_read_reg(ctx, LIS3DH_CTRL_REG4, (uint8_t *)&ctrl_reg4, 1);
-
-  if (ret == 0)
-  {
-    ctrl_reg4.bdu = val & 0x01U;
-    ret = lis3dh_write_reg(ctx, LIS3DH_CTRL_REG4, (uint8_t *)&ctrl_reg4, 1);
-  }
+  ret = lis3dh_field_set(ctx, LIS3DH_FIELD_BDU, val);
 
   return ret;
 }
@@ -860,14 +1309,9 @@ int32_t lis3dh_block_data_update_set(const stmdev_ctx_t *ctx, uint8_t val)
   */
 int32_t lis3dh_block_data_update_get(const stmdev_ctx_t *ctx, uint8_t *val)
 {
-  lis3dh_ctrl_reg4_t ctrl_reg4;
   int32_t ret;
 
-  ret = lis3dh_read_reg(ctx, LIS3DH_CTRL_REG4, (uint8_t *)&ctrl_reg4, 1);
-
-  if (ret != 0) { return ret; }
-
-  *val = (uint8_t)ctrl_reg4.bdu;
+  ret = lis3dh_field_get(ctx, LIS3DH_FIELD_BDU, val);
 
   return ret;
 }
@@ -917,14 +1361,9 @@ int32_t lis3dh_filter_reference_get(const stmdev_ctx_t *ctx, uint8_t *buff)
   */
 int32_t lis3dh_xl_data_ready_get(const stmdev_ctx_t *ctx, uint8_t *val)
 {
-  lis3dh_status_reg_t status_reg;
   int32_t ret;
 
-  ret = lis3dh_read_reg(ctx, LIS3DH_STATUS_REG, (uint8_t *)&status_reg, 1);
-
-  if (ret != 0) { return ret; }
-
-  *val = status_reg.zyxda;
+  ret = lis3dh_field_get(ctx, LIS3DH_FIELD_ZYXDA, val);
 
   return ret;
 }
@@ -938,14 +1377,9 @@ int32_t lis3dh_xl_data_ready_get(const stmdev_ctx_t *ctx, uint8_t *val)
   */
 int32_t lis3dh_xl_data_ovr_get(const stmdev_ctx_t *ctx, uint8_t *val)
 {
-  lis3dh_status_reg_t status_reg;
   int32_t ret;
 
-  ret = lis3dh_read_reg(ctx, LIS3DH_STATUS_REG, (uint8_t *)&status_reg, 1);
-
-  if (ret != 0) { return ret; }
-
-  *val = status_reg.zyxor;
+  ret = lis3dh_field_get(ctx, LIS3DH_FIELD_ZYXOR, val);
 
   return ret;
 }
@@ -972,8 +1406,39 @@ int32_t lis3dh_acceleration_raw_get(const stmdev_ctx_t *ctx, int16_t *val)
 
   return ret;
 }
+
 /**
-  * @}
+  * @brief  Device status and acceleration output value.[get]
+  *         STATUS_REG (27h) directly precedes OUT_X_L (28h), so both
+  *         are read with a single 7 bytes transaction: data ready and
+  *         overrun flags refer to the returned sample.
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  status   register STATUS_REG
+  * @param  val      buffer that stores acceleration data read (3 axes)
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3dh_status_and_accel_get(const stmdev_ctx_t *ctx,
+                                    lis3dh_status_reg_t *status,
+                                    int16_t *val)
+{
+  uint8_t buff[7];
+  int32_t ret;
+
+  ret = lis3dh_read_reg(ctx, LIS3DH_STATUS_REG, buff, 7);
+
+  if (ret != 0) { return ret; }
+
+  *(uint8_t *)status = buff[0];
+  val[0] = (int16_t)(buff[1] | ((uint16_t)buff[2] << 8));
+  val[1] = (int16_t)(buff[3] | ((uint16_t)buff[4] << 8));
+  val[2] = (int16_t)(buff[5] | ((uint16_t)buff[6] << 8));
+
+  return ret;
+}
+/**
+  * @}
   *
   */
 
@@ -1010,16 +1475,9 @@ int32_t lis3dh_device_id_get(const stmdev_ctx_t *ctx, uint8_t *buff)
   */
 int32_t lis3dh_self_test_set(const stmdev_ctx_t *ctx, lis3dh_st_t val)
 {
-  lis3dh_ctrl_reg4_t ctrl_reg4;
   int32_t ret;
 
-  ret = lis3dh_read_reg(ctx, LIS3DH_CTRL_REG4, (uint8_t *)&ctrl_reg4, 1);
-
-  if (ret == 0)
-  {
-    ctrl_reg4.st = (uint8_t)val & 0x03U;
-    ret = lis3dh_write_reg(ctx, LIS3DH_CTRL_REG4, (uint8_t *)&ctrl_reg4, 1);
-  }
+  ret = lis3dh_field_set(ctx, LIS3DH_FIELD_ST, (uint8_t)val);
 
   return ret;
 }
@@ -1073,16 +1531,9 @@ int32_t lis3dh_self_test_get(const stmdev_ctx_t *ctx, lis3dh_st_t *val)
   */
 int32_t lis3dh_data_format_set(const stmdev_ctx_t *ctx, lis3dh_ble_t val)
 {
-  lis3dh_ctrl_reg4_t ctrl_reg4;
   int32_t ret;
 
-  ret = lis3dh_read_reg(ctx, LIS3DH_CTRL_REG4, (uint8_t *)&ctrl_reg4, 1);
-
-  if (ret == 0)
-  {
-    ctrl_reg4.ble = (uint8_t)val & 0x01U;
-    ret = lis3dh_write_reg(ctx, LIS3DH_CTRL_REG4, (uint8_t *)&ctrl_reg4, 1);
-  }
+  ret = lis3dh_field_set(ctx, LIS3DH_FIELD_BLE, (uint8_t)val);
 
   return ret;
 }
@@ -1132,16 +1583,9 @@ int32_t lis3dh_data_format_get(const stmdev_ctx_t *ctx, lis3dh_ble_t *val)
   */
 int32_t lis3dh_boot_set(const stmdev_ctx_t *ctx, uint8_t val)
 {
-  lis3dh_ctrl_reg5_t ctrl_reg5;
   int32_t ret;
 
-  ret = lis3dh_read_reg(ctx, LIS3DH_CTRL_REG5, (uint8_t *)&ctrl_reg5, 1);
-
-  if (ret == 0)
-  {
-    ctrl_reg5.boot = val & 0x01U;
-    ret = lis3dh_write_reg(ctx, LIS3DH_CTRL_REG5, (uint8_t *)&ctrl_reg5, 1);
-  }
+  ret = lis3dh_field_set(ctx, LIS3DH_FIELD_BOOT, val);
 
   return ret;
 }
@@ -1156,14 +1600,9 @@ int32_t lis3dh_boot_set(const stmdev_ctx_t *ctx, uint8_t val)
   */
 int32_t lis3dh_boot_get(const stmdev_ctx_t *ctx, uint8_t *val)
 {
-  lis3dh_ctrl_reg5_t ctrl_reg5;
   int32_t ret;
 
-  ret = lis3dh_read_reg(ctx, LIS3DH_CTRL_REG5, (uint8_t *)&ctrl_reg5, 1);
-
-  if (ret != 0) { return ret; }
-
-  *val = (uint8_t)ctrl_reg5.boot;
+  ret = lis3dh_field_get(ctx, LIS3DH_FIELD_BOOT, val);
 
   return ret;
 }
@@ -1262,16 +1701,9 @@ int32_t lis3dh_int1_gen_source_get(const stmdev_ctx_t *ctx,
   */
 int32_t lis3dh_int1_gen_threshold_set(const stmdev_ctx_t *ctx, uint8_t val)
 {
-  lis3dh_int1_ths_t int1_ths;
   int32_t ret;
 
-  ret = lis3dh_read_reg(ctx, LIS3DH_INT1_THS, (uint8_t *)&int1_ths, 1);
-
-  if (ret == 0)
-  {
-    int1_ths.ths = val & 0x7FU;
-    ret = lis3dh_write_reg(ctx, LIS3DH_INT1_THS, (uint8_t *)&int1_ths, 1);
-  }
+  ret = lis3dh_field_set(ctx, LIS3DH_FIELD_INT1_THS, val);
 
   return ret;
 }
@@ -1288,14 +1720,9 @@ int32_t lis3dh_int1_gen_threshold_set(const stmdev_ctx_t *ctx, uint8_t val)
   */
 int32_t lis3dh_int1_gen_threshold_get(const stmdev_ctx_t *ctx, uint8_t *val)
 {
-  lis3dh_int1_ths_t int1_ths;
   int32_t ret;
 
-  ret = lis3dh_read_reg(ctx, LIS3DH_INT1_THS, (uint8_t *)&int1_ths, 1);
-
-  if (ret != 0) { return ret; }
-
-  *val = (uint8_t)int1_ths.ths;
+  ret = lis3dh_field_get(ctx, LIS3DH_FIELD_INT1_THS, val);
 
   return ret;
 }
@@ -1311,18 +1738,9 @@ int32_t lis3dh_int1_gen_threshold_get(const stmdev_ctx_t *ctx, uint8_t *val)
   */
 int32_t lis3dh_int1_gen_duration_set(const stmdev_ctx_t *ctx, uint8_t val)
 {
-  lis3dh_int1_duration_t int1_duration;
   int32_t ret;
 
-  ret = lis3dh_read_reg(ctx, LIS3DH_INT1_DURATION,
-                        (uint8_t *)&int1_duration, 1);
-
-  if (ret == 0)
-  {
-    int1_duration.d = val & 0x7FU;
-    ret = lis3dh_write_reg(ctx, LIS3DH_INT1_DURATION,
-                           (uint8_t *)&int1_duration, 1);
-  }
+  ret = lis3dh_field_set(ctx, LIS3DH_FIELD_INT1_D, val);
 
   return ret;
 }
@@ -1338,15 +1756,9 @@ int32_t lis3dh_int1_gen_duration_set(const stmdev_ctx_t *ctx, uint8_t val)
   */
 int32_t lis3dh_int1_gen_duration_get(const stmdev_ctx_t *ctx, uint8_t *val)
 {
-  lis3dh_int1_duration_t int1_duration;
   int32_t ret;
 
-  ret = lis3dh_read_reg(ctx, LIS3DH_INT1_DURATION,
-                        (uint8_t *)&int1_duration, 1);
-
-  if (ret != 0) { return ret; }
-
-  *val = (uint8_t)int1_duration.d;
+  ret = lis3dh_field_get(ctx, LIS3DH_FIELD_INT1_D, val);
 
   return ret;
 }
@@ -1428,16 +1840,9 @@ int32_t lis3dh_int2_gen_source_get(const stmdev_ctx_t *ctx,
   */
 int32_t lis3dh_int2_gen_threshold_set(const stmdev_ctx_t *ctx, uint8_t val)
 {
-  lis3dh_int2_ths_t int2_ths;
   int32_t ret;
 
-  ret = lis3dh_read_reg(ctx, LIS3DH_INT2_THS, (uint8_t *)&int2_ths, 1);
-
-  if (ret == 0)
-  {
-    int2_ths.ths = val & 0x7FU;
-    ret = lis3dh_write_reg(ctx, LIS3DH_INT2_THS, (uint8_t *)&int2_ths, 1);
-  }
+  ret = lis3dh_field_set(ctx, LIS3DH_FIELD_INT2_THS, val);
 
   return ret;
 }
@@ -1454,14 +1859,9 @@ int32_t lis3dh_int2_gen_threshold_set(const stmdev_ctx_t *ctx, uint8_t val)
   */
 int32_t lis3dh_int2_gen_threshold_get(const stmdev_ctx_t *ctx, uint8_t *val)
 {
-  lis3dh_int2_ths_t int2_ths;
   int32_t ret;
 
-  ret = lis3dh_read_reg(ctx, LIS3DH_INT2_THS, (uint8_t *)&int2_ths, 1);
-
-  if (ret != 0) { return ret; }
-
-  *val = (uint8_t)int2_ths.ths;
+  ret = lis3dh_field_get(ctx, LIS3DH_FIELD_INT2_THS, val);
 
   return ret;
 }
@@ -1477,18 +1877,9 @@ int32_t lis3dh_int2_gen_threshold_get(const stmdev_ctx_t *ctx, uint8_t *val)
   */
 int32_t lis3dh_int2_gen_duration_set(const stmdev_ctx_t *ctx, uint8_t val)
 {
-  lis3dh_int2_duration_t int2_duration;
   int32_t ret;
 
-  ret = lis3dh_read_reg(ctx, LIS3DH_INT2_DURATION,
-                        (uint8_t *)&int2_duration, 1);
-
-  if (ret == 0)
-  {
-    int2_duration.d = val & 0x7FU;
-    ret = lis3dh_write_reg(ctx, LIS3DH_INT2_DURATION,
-                           (uint8_t *)&int2_duration, 1);
-  }
+  ret = lis3dh_field_set(ctx, LIS3DH_FIELD_INT2_D, val);
 
   return ret;
 }
@@ -1504,15 +1895,9 @@ int32_t lis3dh_int2_gen_duration_set(const stmdev_ctx_t *ctx, uint8_t val)
   */
 int32_t lis3dh_int2_gen_duration_get(const stmdev_ctx_t *ctx, uint8_t *val)
 {
-  lis3dh_int2_duration_t int2_duration;
   int32_t ret;
 
-  ret = lis3dh_read_reg(ctx, LIS3DH_INT2_DURATION,
-                        (uint8_t *)&int2_duration, 1);
-
-  if (ret != 0) { return ret; }
-
-  *val = (uint8_t)int2_duration.d;
+  ret = lis3dh_field_get(ctx, LIS3DH_FIELD_INT2_D, val);
 
   return ret;
 }
@@ -1540,16 +1925,9 @@ int32_t lis3dh_int2_gen_duration_get(const stmdev_ctx_t *ctx, uint8_t *val)
 int32_t lis3dh_high_pass_int_conf_set(const stmdev_ctx_t *ctx,
                                       lis3dh_hp_t val)
 {
-  lis3dh_ctrl_reg2_t ctrl_reg2;
   int32_t ret;
 
-  ret = lis3dh_read_reg(ctx, LIS3DH_CTRL_REG2, (uint8_t *)&ctrl_reg2, 1);
-
-  if (ret == 0)
-  {
-    ctrl_reg2.hp = (uint8_t)val & 0x07U;
-    ret = lis3dh_write_reg(ctx, LIS3DH_CTRL_REG2, (uint8_t *)&ctrl_reg2, 1);
-  }
+  ret = lis3dh_field_set(ctx, LIS3DH_FIELD_HP, (uint8_t)val);
 
   return ret;
 }
@@ -1661,16 +2039,9 @@ int32_t lis3dh_pin_int1_config_get(const stmdev_ctx_t *ctx,
   */
 int32_t lis3dh_int2_pin_detect_4d_set(const stmdev_ctx_t *ctx, uint8_t val)
 {
-  lis3dh_ctrl_reg5_t ctrl_reg5;
   int32_t ret;
 
-  ret = lis3dh_read_reg(ctx, LIS3DH_CTRL_REG5, (uint8_t *)&ctrl_reg5, 1);
-
-  if (ret == 0)
-  {
-    ctrl_reg5.d4d_int2 = val & 0x01U;
-    ret = lis3dh_write_reg(ctx, LIS3DH_CTRL_REG5, (uint8_t *)&ctrl_reg5, 1);
-  }
+  ret = lis3dh_field_set(ctx, LIS3DH_FIELD_D4D_INT2, val);
 
   return ret;
 }
@@ -1686,14 +2057,9 @@ int32_t lis3dh_int2_pin_detect_4d_set(const stmdev_ctx_t *ctx, uint8_t val)
   */
 int32_t lis3dh_int2_pin_detect_4d_get(const stmdev_ctx_t *ctx, uint8_t *val)
 {
-  lis3dh_ctrl_reg5_t ctrl_reg5;
   int32_t ret;
 
-  ret = lis3dh_read_reg(ctx, LIS3DH_CTRL_REG5, (uint8_t *)&ctrl_reg5, 1);
-
-  if (ret != 0) { return ret; }
-
-  *val = (uint8_t)ctrl_reg5.d4d_int2;
+  ret = lis3dh_field_get(ctx, LIS3DH_FIELD_D4D_INT2, val);
 
   return ret;
 }
@@ -1711,16 +2077,9 @@ int32_t lis3dh_int2_pin_detect_4d_get(const stmdev_ctx_t *ctx, uint8_t *val)
 int32_t lis3dh_int2_pin_notification_mode_set(const stmdev_ctx_t *ctx,
                                               lis3dh_lir_int2_t val)
 {
-  lis3dh_ctrl_reg5_t ctrl_reg5;
   int32_t ret;
 
-  ret = lis3dh_read_reg(ctx, LIS3DH_CTRL_REG5, (uint8_t *)&ctrl_reg5, 1);
-
-  if (ret == 0)
-  {
-    ctrl_reg5.lir_int2 = (uint8_t)val & 0x01U;
-    ret = lis3dh_write_reg(ctx, LIS3DH_CTRL_REG5, (uint8_t *)&ctrl_reg5, 1);
-  }
+  ret = lis3dh_field_set(ctx, LIS3DH_FIELD_LIR_INT2, (uint8_t)val);
 
   return ret;
 }
@@ -1774,16 +2133,9 @@ int32_t lis3dh_int2_pin_notification_mode_get(const stmdev_ctx_t *ctx,
   */
 int32_t lis3dh_int1_pin_detect_4d_set(const stmdev_ctx_t *ctx, uint8_t val)
 {
-  lis3dh_ctrl_reg5_t ctrl_reg5;
   int32_t ret;
 
-  ret = lis3dh_read_reg(ctx, LIS3DH_CTRL_REG5, (uint8_t *)&ctrl_reg5, 1);
-
-  if (ret == 0)
-  {
-    ctrl_reg5.d4d_int1 = val & 0x01U;
-    ret = lis3dh_write_reg(ctx, LIS3DH_CTRL_REG5, (uint8_t *)&ctrl_reg5, 1);
-  }
+  ret = lis3dh_field_set(ctx, LIS3DH_FIELD_D4D_INT1, val);
 
   return ret;
 }
@@ -1799,14 +2151,9 @@ int32_t lis3dh_int1_pin_detect_4d_set(const stmdev_ctx_t *ctx, uint8_t val)
   */
 int32_t lis3dh_int1_pin_detect_4d_get(const stmdev_ctx_t *ctx, uint8_t *val)
 {
-  lis3dh_ctrl_reg5_t ctrl_reg5;
   int32_t ret;
 
-  ret = lis3dh_read_reg(ctx, LIS3DH_CTRL_REG5, (uint8_t *)&ctrl_reg5, 1);
-
-  if (ret != 0) { return ret; }
-
-  *val = (uint8_t)ctrl_reg5.d4d_int1;
+  ret = lis3dh_field_get(ctx, LIS3DH_FIELD_D4D_INT1, val);
 
   return ret;
 }
@@ -1823,16 +2170,9 @@ int32_t lis3dh_int1_pin_detect_4d_get(const stmdev_ctx_t *ctx, uint8_t *val)
 int32_t lis3dh_int1_pin_notification_mode_set(const stmdev_ctx_t *ctx,
                                               lis3dh_lir_int1_t val)
 {
-  lis3dh_ctrl_reg5_t ctrl_reg5;
   int32_t ret;
 
-  ret = lis3dh_read_reg(ctx, LIS3DH_CTRL_REG5, (uint8_t *)&ctrl_reg5, 1);
-
-  if (ret == 0)
-  {
-    ctrl_reg5.lir_int1 = (uint8_t)val & 0x01U;
-    ret = lis3dh_write_reg(ctx, LIS3DH_CTRL_REG5, (uint8_t *)&ctrl_reg5, 1);
-  }
+  ret = lis3dh_field_set(ctx, LIS3DH_FIELD_LIR_INT1, (uint8_t)val);
 
   return ret;
 }
@@ -1931,16 +2271,9 @@ int32_t lis3dh_pin_int2_config_get(const stmdev_ctx_t *ctx,
   */
 int32_t lis3dh_fifo_set(const stmdev_ctx_t *ctx, uint8_t val)
 {
-  lis3dh_ctrl_reg5_t ctrl_reg5;
   int32_t ret;
 
-  ret = lis3dh_read_reg(ctx, LIS3DH_CTRL_REG5, (uint8_t *)&ctrl_reg5, 1);
-
-  if (ret == 0)
-  {
-    ctrl_reg5.fifo_en = val & 0x01U;
-    ret = lis3dh_write_reg(ctx, LIS3DH_CTRL_REG5, (uint8_t *)&ctrl_reg5, 1);
-  }
+  ret = lis3dh_field_set(ctx, LIS3DH_FIELD_FIFO_EN, val);
 
   return ret;
 }
@@ -1955,14 +2288,9 @@ int32_t lis3dh_fifo_set(const stmdev_ctx_t *ctx, uint8_t val)
   */
 int32_t lis3dh_fifo_get(const stmdev_ctx_t *ctx, uint8_t *val)
 {
-  lis3dh_ctrl_reg5_t ctrl_reg5;
   int32_t ret;
 
-  ret = lis3dh_read_reg(ctx, LIS3DH_CTRL_REG5, (uint8_t *)&ctrl_reg5, 1);
-
-  if (ret != 0) { return ret; }
-
-  *val = (uint8_t)ctrl_reg5.fifo_en;
+  ret = lis3dh_field_get(ctx, LIS3DH_FIELD_FIFO_EN, val);
 
   return ret;
 }
@@ -1977,18 +2305,9 @@ int32_t lis3dh_fifo_get(const stmdev_ctx_t *ctx, uint8_t *val)
   */
 int32_t lis3dh_fifo_watermark_set(const stmdev_ctx_t *ctx, uint8_t val)
 {
-  lis3dh_fifo_ctrl_reg_t fifo_ctrl_reg;
   int32_t ret;
 
-  ret = lis3dh_read_reg(ctx, LIS3DH_FIFO_CTRL_REG,
-                        (uint8_t *)&fifo_ctrl_reg, 1);
-
-  if (ret == 0)
-  {
-    fifo_ctrl_reg.fth = val & 0x1FU;
-    ret = lis3dh_write_reg(ctx, LIS3DH_FIFO_CTRL_REG,
-                           (uint8_t *)&fifo_ctrl_reg, 1);
-  }
+  ret = lis3dh_field_set(ctx, LIS3DH_FIELD_FTH, val);
 
   return ret;
 }
@@ -2003,15 +2322,9 @@ int32_t lis3dh_fifo_watermark_set(const stmdev_ctx_t *ctx, uint8_t val)
   */
 int32_t lis3dh_fifo_watermark_get(const stmdev_ctx_t *ctx, uint8_t *val)
 {
-  lis3dh_fifo_ctrl_reg_t fifo_ctrl_reg;
   int32_t ret;
 
-  ret = lis3dh_read_reg(ctx, LIS3DH_FIFO_CTRL_REG,
-                        (uint8_t *)&fifo_ctrl_reg, 1);
-
-  if (ret != 0) { return ret; }
-
-  *val = (uint8_t)fifo_ctrl_reg.fth;
+  ret = lis3dh_field_get(ctx, LIS3DH_FIELD_FTH, val);
 
   return ret;
 }
@@ -2027,18 +2340,9 @@ int32_t lis3dh_fifo_watermark_get(const stmdev_ctx_t *ctx, uint8_t *val)
 int32_t lis3dh_fifo_trigger_event_set(const stmdev_ctx_t *ctx,
                                       lis3dh_tr_t val)
 {
-  lis3dh_fifo_ctrl_reg_t fifo_ctrl_reg;
   int32_t ret;
 
-  ret = lis3dh_read_reg(ctx, LIS3DH_FIFO_CTRL_REG,
-                        (uint8_t *)&fifo_ctrl_reg, 1);
-
-  if (ret == 0)
-  {
-    fifo_ctrl_reg.tr = (uint8_t)val & 0x01U;
-    ret = lis3dh_write_reg(ctx, LIS3DH_FIFO_CTRL_REG,
-                           (uint8_t *)&fifo_ctrl_reg, 1);
-  }
+  ret = lis3dh_field_set(ctx, LIS3DH_FIELD_TR, (uint8_t)val);
 
   return ret;
 }
@@ -2090,18 +2394,9 @@ int32_t lis3dh_fifo_trigger_event_get(const stmdev_ctx_t *ctx,
   */
 int32_t lis3dh_fifo_mode_set(const stmdev_ctx_t *ctx, lis3dh_fm_t val)
 {
-  lis3dh_fifo_ctrl_reg_t fifo_ctrl_reg;
   int32_t ret;
 
-  ret = lis3dh_read_reg(ctx, LIS3DH_FIFO_CTRL_REG,
-                        (uint8_t *)&fifo_ctrl_reg, 1);
-
-  if (ret == 0)
-  {
-    fifo_ctrl_reg.fm = (uint8_t)val & 0x03U;
-    ret = lis3dh_write_reg(ctx, LIS3DH_FIFO_CTRL_REG,
-                           (uint8_t *)&fifo_ctrl_reg, 1);
-  }
+  ret = lis3dh_field_set(ctx, LIS3DH_FIELD_FM, (uint8_t)val);
 
   return ret;
 }
@@ -2177,15 +2472,9 @@ int32_t lis3dh_fifo_status_get(const stmdev_ctx_t *ctx,
   */
 int32_t lis3dh_fifo_data_level_get(const stmdev_ctx_t *ctx, uint8_t *val)
 {
-  lis3dh_fifo_src_reg_t fifo_src_reg;
   int32_t ret;
 
-  ret = lis3dh_read_reg(ctx, LIS3DH_FIFO_SRC_REG,
-                        (uint8_t *)&fifo_src_reg, 1);
-
-  if (ret != 0) { return ret; }
-
-  *val = (uint8_t)fifo_src_reg.fss;
+  ret = lis3dh_field_get(ctx, LIS3DH_FIELD_FSS, val);
 
   return ret;
 }
@@ -2199,15 +2488,9 @@ int32_t lis3dh_fifo_data_level_get(const stmdev_ctx_t *ctx, uint8_t *val)
   */
 int32_t lis3dh_fifo_empty_flag_get(const stmdev_ctx_t *ctx, uint8_t *val)
 {
-  lis3dh_fifo_src_reg_t fifo_src_reg;
   int32_t ret;
 
-  ret = lis3dh_read_reg(ctx, LIS3DH_FIFO_SRC_REG,
-                        (uint8_t *)&fifo_src_reg, 1);
-
-  if (ret != 0) { return ret; }
-
-  *val = (uint8_t)fifo_src_reg.empty;
+  ret = lis3dh_field_get(ctx, LIS3DH_FIELD_EMPTY, val);
 
   return ret;
 }
@@ -2221,15 +2504,9 @@ int32_t lis3dh_fifo_empty_flag_get(const stmdev_ctx_t *ctx, uint8_t *val)
   */
 int32_t lis3dh_fifo_ovr_flag_get(const stmdev_ctx_t *ctx, uint8_t *val)
 {
-  lis3dh_fifo_src_reg_t fifo_src_reg;
   int32_t ret;
 
-  ret = lis3dh_read_reg(ctx, LIS3DH_FIFO_SRC_REG,
-                        (uint8_t *)&fifo_src_reg, 1);
-
-  if (ret != 0) { return ret; }
-
-  *val = (uint8_t)fifo_src_reg.ovrn_fifo;
+  ret = lis3dh_field_get(ctx, LIS3DH_FIELD_OVRN_FIFO, val);
 
   return ret;
 }
@@ -2243,354 +2520,1458 @@ int32_t lis3dh_fifo_ovr_flag_get(const stmdev_ctx_t *ctx, uint8_t *val)
   */
 int32_t lis3dh_fifo_fth_flag_get(const stmdev_ctx_t *ctx, uint8_t *val)
 {
-  lis3dh_fifo_src_reg_t fifo_src_reg;
   int32_t ret;
 
-  ret = lis3dh_read_reg(ctx, LIS3DH_FIFO_SRC_REG,
-                        (uint8_t *)&fifo_src_reg, 1);
-
-  if (ret != 0) { return ret; }
-
-  *val = (uint8_t)fifo_src_reg.wtm;
+  ret = lis3dh_field_get(ctx, LIS3DH_FIELD_WTM, val);
 
   return ret;
 }
+
 /**
-  * @}
+  * @brief  Number of samples stored in FIFO, from FIFO_SRC_REG content.
+  *         fss saturates at 31: overrun means all the FIFO slots are in
+  *         use. Together with lis3dh_fifo_data_decode it allows a
+  *         non-blocking (i.e. DMA driven) bus to run the FIFO_SRC_REG and
+  *         OUT_X_L transfers on its own and decode them on completion.
+  *
+  * @param  val      register FIFO_SRC_REG
+  * @retval          number of samples available
   *
   */
+uint8_t lis3dh_fifo_level_decode(const lis3dh_fifo_src_reg_t *val)
+{
+  uint8_t level;
+
+  if (val->ovrn_fifo == PROPERTY_ENABLE)
+  {
+    level = (uint8_t)LIS3DH_FIFO_DEPTH;
+  }
+
+  else
+  {
+    level = (uint8_t)val->fss;
+  }
+
+  return level;
+}
 
 /**
-  * @defgroup  LIS3DH_Tap_generator
-  * @brief     This section group all the functions that manage the tap and
-  *            double tap event generation
-  * @{
+  * @brief  Unpack raw FIFO bytes read from OUT_X_L (6 bytes per sample).
+  *         buff may alias xyz: each int16_t is rebuilt over its own two
+  *         bytes, so the data can be decoded in place.
+  *
+  * @param  buff     raw bytes (level * 6)
+  * @param  xyz      buffer that stores the samples (level entries)
+  * @param  level    number of samples
   *
   */
+void lis3dh_fifo_data_decode(const uint8_t *buff, int16_t (*xyz)[3],
+                             uint8_t level)
+{
+  uint8_t i;
+  uint8_t j;
+
+  for (i = 0; i < level; i++)
+  {
+    for (j = 0; j < 3U; j++)
+    {
+      xyz[i][j] = (int16_t)(buff[(6U * i) + (2U * j)] |
+                            ((uint16_t)buff[(6U * i) + (2U * j) + 1U] << 8));
+    }
+  }
+}
 
 /**
-  * @brief  Tap/Double Tap generator configuration register.[set]
+  * @brief  Read the samples stored in FIFO.[get]
+  *         FIFO_SRC_REG is read first, then all the available samples
+  *         (up to max) are fetched with a single multi-byte read starting
+  *         from OUT_X_L: with FIFO enabled the device rolls the address
+  *         back from OUT_Z_H to OUT_X_L at each sample.
+  *         As for any other multi-byte access, the auto-increment bit is
+  *         managed by the platform read function.
   *
   * @param  ctx      read / write interface definitions
-  * @param  val      registers CLICK_CFG
+  * @param  xyz      buffer that stores the samples read (max entries)
+  * @param  max      maximum number of samples to read
+  * @param  got      number of samples stored in xyz
   * @retval          interface status (MANDATORY: return 0 -> no Error)
   *
   */
-int32_t lis3dh_tap_conf_set(const stmdev_ctx_t *ctx,
-                            lis3dh_click_cfg_t *val)
+int32_t lis3dh_fifo_data_read(const stmdev_ctx_t *ctx, int16_t (*xyz)[3],
+                              uint8_t max, uint8_t *got)
 {
+  lis3dh_fifo_src_reg_t fifo_src_reg;
+  uint8_t *buff;
+  uint8_t level;
   int32_t ret;
 
-  ret = lis3dh_write_reg(ctx, LIS3DH_CLICK_CFG, (uint8_t *) val, 1);
+  *got = 0;
+
+  ret = lis3dh_read_reg(ctx, LIS3DH_FIFO_SRC_REG,
+                        (uint8_t *)&fifo_src_reg, 1);
+
+  if (ret != 0) { return ret; }
+
+  level = lis3dh_fifo_level_decode(&fifo_src_reg);
+
+  if (level > max)
+  {
+    level = max;
+  }
+
+  if (level == 0U)
+  {
+    return ret;
+  }
+
+  buff = (uint8_t *)xyz;
+  ret = lis3dh_read_reg(ctx, LIS3DH_OUT_X_L, buff, (uint16_t)(level * 6U));
+
+  if (ret != 0) { return ret; }
+
+  lis3dh_fifo_data_decode(buff, xyz, level);
+
+  *got = level;
 
   return ret;
 }
 
 /**
-  * @brief  Tap/Double Tap generator configuration register.[get]
-  *
-  * @param  ctx      read / write interface definitions
-  * @param  val      registers CLICK_CFG
-  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  * @}
   *
   */
-int32_t lis3dh_tap_conf_get(const stmdev_ctx_t *ctx,
-                            lis3dh_click_cfg_t *val)
-{
-  int32_t ret;
 
-  ret = lis3dh_read_reg(ctx, LIS3DH_CLICK_CFG, (uint8_t *) val, 1);
+/**
+  * @defgroup  LIS3DH_Fifo_watermark_control
+  * @brief     This section group the functions of the adaptive FIFO
+  *            watermark controller.
+  * @{
+  *
+  */
 
-  return ret;
-}
 /**
-  * @brief  Tap/Double Tap generator source register.[get]
+  * @brief  Start the adaptive FIFO watermark controller.
+  *         The watermark is set to fth_min (lowest latency) and raised
+  *         while the host keeps up, up to fth_max: choose fth_max as
+  *         the maximum acceptable latency multiplied by the ODR.
   *
   * @param  ctx      read / write interface definitions
-  * @param  val      registers CLICK_SRC
+  * @param  val      controller state(ptr)
+  * @param  fth_min  minimum watermark level
+  * @param  fth_max  maximum watermark level (at most 31)
   * @retval          interface status (MANDATORY: return 0 -> no Error)
   *
   */
-int32_t lis3dh_tap_source_get(const stmdev_ctx_t *ctx,
-                              lis3dh_click_src_t *val)
+int32_t lis3dh_fifo_wtm_ctrl_init(const stmdev_ctx_t *ctx,
+                                  lis3dh_fifo_wtm_ctrl_t *val,
+                                  uint8_t fth_min, uint8_t fth_max)
 {
-  int32_t ret;
+  if ((fth_min > fth_max) || (fth_max >= LIS3DH_FIFO_DEPTH))
+  {
+    return -1;
+  }
 
-  ret = lis3dh_read_reg(ctx, LIS3DH_CLICK_SRC, (uint8_t *) val, 1);
+  val->fth = fth_min;
+  val->fth_min = fth_min;
+  val->fth_max = fth_max;
+  val->streak = 0;
+  val->wakeups = 0;
+  val->samples = 0;
+  val->overruns = 0;
 
-  return ret;
+  return lis3dh_fifo_watermark_set(ctx, fth_min);
 }
+
 /**
-  * @brief  User-defined threshold value for Tap/Double Tap event.[set]
-  *         1 LSB = full scale/128
+  * @brief  Retune the FIFO watermark after a drain.
+  *         The samples found above the watermark measure the service
+  *         latency: the watermark is raised by one after 8 drains in a
+  *         row where the free FIFO space was more than twice that
+  *         latency, lowered by one as soon as the space is less than the
+  *         latency, and halved on overrun.
+  *         FIFO_CTRL_REG is written only when the level changes.
+  *         wakeups, samples and overruns count the serviced drains, so
+  *         samples / wakeups is the average number of samples per wakeup.
   *
   * @param  ctx      read / write interface definitions
-  * @param  val      change the values of ths in reg CLICK_THS
+  * @param  val      controller state(ptr)
+  * @param  level    samples found in FIFO at service time
+  * @param  ovr      FIFO overrun flag read at service time
   * @retval          interface status (MANDATORY: return 0 -> no Error)
   *
   */
-int32_t lis3dh_tap_threshold_set(const stmdev_ctx_t *ctx, uint8_t val)
+int32_t lis3dh_fifo_wtm_ctrl_update(const stmdev_ctx_t *ctx,
+                                    lis3dh_fifo_wtm_ctrl_t *val,
+                                    uint8_t level, uint8_t ovr)
 {
-  lis3dh_click_ths_t click_ths;
-  int32_t ret;
+  uint8_t fth = val->fth;
+  uint8_t latency;
+  uint8_t space;
 
-  ret = lis3dh_read_reg(ctx, LIS3DH_CLICK_THS, (uint8_t *)&click_ths, 1);
+  val->wakeups++;
+  val->samples += level;
 
-  if (ret == 0)
+  if (ovr == PROPERTY_ENABLE)
   {
-    click_ths.ths = val & 0x7FU;
-    ret = lis3dh_write_reg(ctx, LIS3DH_CLICK_THS, (uint8_t *)&click_ths, 1);
+    val->overruns++;
+    val->streak = 0;
+    fth = (uint8_t)(fth / 2U);
   }
 
-  return ret;
-}
+  else if (level > fth)
+  {
+    latency = (uint8_t)(level - fth);
+    space = (uint8_t)(LIS3DH_FIFO_DEPTH - level);
 
-/**
-  * @brief  User-defined threshold value for Tap/Double Tap event.[get]
+    if (space > (2U * latency))
+    {
+      val->streak++;
+    }
+
+    else
+    {
+      val->streak = 0;
+    }
+
+    if (val->streak >= 8U)
+    {
+      val->streak = 0;
+      fth++;
+    }
+
+    if ((space < latency) && (fth > val->fth_min))
+    {
+      fth--;
+    }
+  }
+
+  else
+  {
+    /* drained before reaching the watermark: nothing to learn */
+  }
+
+  if (fth < val->fth_min)
+  {
+    fth = val->fth_min;
+  }
+
+  if (fth > val->fth_max)
+  {
+    fth = val->fth_max;
+  }
+
+  if (fth == val->fth)
+  {
+    return 0;
+  }
+
+  val->fth = fth;
+
+  return lis3dh_fifo_watermark_set(ctx, fth);
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup  LIS3DH_Timestamp
+  * @brief     This section group the functions that rebuild per-sample
+  *            timestamps of FIFO data from the drain times.
+  * @{
+  *
+  */
+
+/**
+  * @brief  Nominal output data rate in Hz.
+  *
+  * @param  odr      data rate selected in CTRL_REG1
+  * @param  mode     operating mode (the two highest rates depend on it)
+  * @param  val      nominal data rate in Hz, 0 on error
+  * @retval          0 on success, -1 if the device is in power down or
+  *                  the combination is not valid
+  *
+  */
+int32_t lis3dh_data_rate_to_hz(lis3dh_odr_t odr, lis3dh_op_md_t mode,
+                               uint32_t *val)
+{
+  int32_t ret = 0;
+
+  switch (odr)
+  {
+    case LIS3DH_ODR_1Hz:
+      *val = 1U;
+      break;
+
+    case LIS3DH_ODR_10Hz:
+      *val = 10U;
+      break;
+
+    case LIS3DH_ODR_25Hz:
+      *val = 25U;
+      break;
+
+    case LIS3DH_ODR_50Hz:
+      *val = 50U;
+      break;
+
+    case LIS3DH_ODR_100Hz:
+      *val = 100U;
+      break;
+
+    case LIS3DH_ODR_200Hz:
+      *val = 200U;
+      break;
+
+    case LIS3DH_ODR_400Hz:
+      *val = 400U;
+      break;
+
+    case LIS3DH_ODR_1kHz620_LP:
+      if (mode == LIS3DH_LP_8bit)
+      {
+        *val = 1620U;
+      }
+      else
+      {
+        *val = 0U;
+        ret = -1;
+      }
+      break;
+
+    case LIS3DH_ODR_5kHz376_LP_1kHz344_NM_HP:
+      *val = (mode == LIS3DH_LP_8bit) ? 5376U : 1344U;
+      break;
+
+    default:
+      *val = 0U;
+      ret = -1;
+      break;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  Initialize the FIFO timestamp tracker with the nominal rate.
+  *
+  * @param  ts       tracker state(ptr)
+  * @param  odr_hz   nominal data rate in Hz (see lis3dh_data_rate_to_hz)
+  * @retval          0 on success, -1 if odr_hz is 0
+  *
+  */
+int32_t lis3dh_fifo_ts_init(lis3dh_fifo_ts_t *ts, uint32_t odr_hz)
+{
+  if (odr_hz == 0U)
+  {
+    return -1;
+  }
+
+  ts->last = 0;
+  ts->period = (1000000U * 256U) / odr_hz;
+  ts->valid = PROPERTY_DISABLE;
+
+  return 0;
+}
+
+/**
+  * @brief  Assign a timestamp to each sample of a FIFO drain and track
+  *         the real data rate of the device.
+  *         The newest sample of the drain is stamped with now and the
+  *         older ones are spaced by the estimated period. The interval
+  *         between two drains, divided by the samples it produced,
+  *         refines the period through a 1/8 gain filter; measures
+  *         farther than 1/8 from the estimate (i.e. a missed drain) are
+  *         clamped. After an overrun samples have been lost, so the
+  *         period is not updated.
+  *         For consistent results always drain the FIFO completely and
+  *         take now right before reading FIFO_SRC_REG.
+  *
+  * @param  ts       tracker state(ptr)
+  * @param  now      [us] time of the drain
+  * @param  level    number of samples drained
+  * @param  ovr      FIFO overrun flag read with the samples
+  * @param  stamp    [us] timestamps of the samples, oldest first
+  *                  (level entries)
+  *
+  */
+void lis3dh_fifo_ts_update(lis3dh_fifo_ts_t *ts, uint64_t now,
+                           uint8_t level, uint8_t ovr, uint64_t *stamp)
+{
+  uint64_t meas;
+  uint32_t min;
+  uint32_t max;
+  uint8_t i;
+
+  if (level == 0U)
+  {
+    return;
+  }
+
+  if ((ts->valid == PROPERTY_ENABLE) && (ovr == PROPERTY_DISABLE) &&
+      (now > ts->last))
+  {
+    meas = ((now - ts->last) * 256U) / level;
+    min = ts->period - (ts->period / 8U);
+    max = ts->period + (ts->period / 8U);
+
+    if (meas < min)
+    {
+      meas = min;
+    }
+
+    if (meas > max)
+    {
+      meas = max;
+    }
+
+    ts->period = (uint32_t)(((7U * (uint64_t)ts->period) + meas) / 8U);
+  }
+
+  for (i = 0; i < level; i++)
+  {
+    stamp[i] = now - ((((uint64_t)level - 1U - i) * ts->period) / 256U);
+  }
+
+  ts->last = now;
+  ts->valid = PROPERTY_ENABLE;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup  LIS3DH_Statistics
+  * @brief     This section group the functions that accumulate running
+  *            statistics of raw samples, per axis, in a single pass.
+  * @{
+  *
+  */
+
+/**
+  * @brief  Clear a statistics accumulator.
+  *
+  * @param  val      accumulator(ptr)
+  *
+  */
+void lis3dh_stats_init(lis3dh_stats_t *val)
+{
+  uint8_t i;
+
+  val->n = 0;
+
+  for (i = 0; i < 3U; i++)
+  {
+    val->min[i] = INT16_MAX;
+    val->max[i] = INT16_MIN;
+    val->sum[i] = 0;
+    val->sum_sq[i] = 0;
+  }
+}
+
+/**
+  * @brief  Fold a block of raw samples, as returned by
+  *         lis3dh_fifo_data_read, into the accumulator.
+  *         Only integer sums are kept, so the result does not depend
+  *         on block boundaries and no conversion is done per sample.
+  *         Up to 2^32 - 1 samples can be accumulated.
+  *
+  * @param  val      accumulator(ptr)
+  * @param  xyz      raw samples, x / y / z (n entries), not modified
+  * @param  n        number of samples
+  *
+  */
+void lis3dh_stats_update(lis3dh_stats_t *val, int16_t (*xyz)[3],
+                         size_t n)
+{
+  int32_t s;
+  size_t j;
+  uint8_t i;
+
+  for (j = 0; j < n; j++)
+  {
+    for (i = 0; i < 3U; i++)
+    {
+      s = xyz[j][i];
+
+      if (xyz[j][i] < val->min[i])
+      {
+        val->min[i] = xyz[j][i];
+      }
+
+      if (xyz[j][i] > val->max[i])
+      {
+        val->max[i] = xyz[j][i];
+      }
+
+      val->sum[i] += s;
+      val->sum_sq[i] += (uint64_t)((uint32_t)(s * s));
+    }
+  }
+
+  val->n += (uint32_t)n;
+}
+
+/**
+  * @brief  Add the samples of src to val, as if they had been folded
+  *         into val directly. Lets partial results from several
+  *         threads, blocks or sensors be combined.
+  *
+  * @param  val      accumulator(ptr)
+  * @param  src      accumulator to add(ptr)
+  *
+  */
+void lis3dh_stats_merge(lis3dh_stats_t *val, const lis3dh_stats_t *src)
+{
+  uint8_t i;
+
+  if (src->n == 0U)
+  {
+    return;
+  }
+
+  for (i = 0; i < 3U; i++)
+  {
+    if (src->min[i] < val->min[i])
+    {
+      val->min[i] = src->min[i];
+    }
+
+    if (src->max[i] > val->max[i])
+    {
+      val->max[i] = src->max[i];
+    }
+
+    val->sum[i] += src->sum[i];
+    val->sum_sq[i] += src->sum_sq[i];
+  }
+
+  val->n += src->n;
+}
+
+/**
+  * @brief  Integer square root, rounded down.
+  *         Used instead of sqrtf so that the driver does not depend on
+  *         the math library.
+  *
+  * @param  val      radicand
+  * @retval          floor(sqrt(val))
+  *
+  */
+static uint32_t lis3dh_isqrt(uint64_t val)
+{
+  uint64_t bit = (uint64_t)1U << 62;
+  uint64_t res = 0;
+
+  while (bit > val)
+  {
+    bit >>= 2;
+  }
+
+  while (bit != 0U)
+  {
+    if (val >= (res + bit))
+    {
+      val -= res + bit;
+      res = (res >> 1) + bit;
+    }
+    else
+    {
+      res >>= 1;
+    }
+    bit >>= 2;
+  }
+
+  return (uint32_t)res;
+}
+
+/**
+  * @brief  Statistics in mg.[get]
+  *         The sensitivity of mode and fs is applied here only. The
+  *         variance is taken from the exact integer sums: with
+  *         sum = q * n + r, n * var = sum_sq - q * (sum + r) - r^2 / n,
+  *         where only the last term (below n) is not an integer, so no
+  *         cancellation occurs when the mean (gravity) is much larger
+  *         than the vibration. RMS is the integer square root of
+  *         the mean square taken with 16 fractional bits, so it is
+  *         exact to 1/256 LSB.
+  *
+  * @param  val      accumulator(ptr)
+  * @param  mode     operating mode the samples were acquired with
+  * @param  fs       full scale the samples were acquired with
+  * @param  out      statistics in mg(ptr)
+  * @retval          0 on success, -1 if no sample has been folded in
+  *                  or mode or fs are not valid
+  *
+  */
+int32_t lis3dh_stats_get(const lis3dh_stats_t *val, lis3dh_op_md_t mode,
+                         lis3dh_fs_t fs, lis3dh_stats_mg_t *out)
+{
+  float_t sens;
+  float_t n;
+  float_t m2;
+  uint64_t ms;
+  int64_t q;
+  int64_t r;
+  int32_t peak;
+  uint8_t i;
+
+  if ((val->n == 0U) || (lis3dh_sensitivity_check(mode, fs) != 0))
+  {
+    return -1;
+  }
+
+  sens = lis3dh_mg_per_lsb[mode][fs];
+  n = (float_t)val->n;
+
+  for (i = 0; i < 3U; i++)
+  {
+    q = val->sum[i] / (int64_t)val->n;
+    r = val->sum[i] - (q * (int64_t)val->n);
+    m2 = (float_t)((int64_t)val->sum_sq[i] - (q * (val->sum[i] + r)));
+    m2 -= ((float_t)r * (float_t)r) / n;
+
+    if (m2 < 0.0f)
+    {
+      m2 = 0.0f;
+    }
+
+    peak = -(int32_t)val->min[i];
+    if ((int32_t)val->max[i] > peak)
+    {
+      peak = val->max[i];
+    }
+
+    out->mean[i] = ((float_t)val->sum[i] / n) * sens;
+    out->var[i] = (m2 / n) * sens * sens;
+    ms = ((val->sum_sq[i] / val->n) << 16) +
+         (((val->sum_sq[i] % val->n) << 16) / val->n);
+    out->rms[i] = ((float_t)lis3dh_isqrt(ms) / 256.0f) * sens;
+    out->peak[i] = (float_t)peak * sens;
+    out->crest[i] = (out->rms[i] > 0.0f) ? (out->peak[i] / out->rms[i]) :
+                    0.0f;
+  }
+
+  return 0;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup  LIS3DH_Tap_generator
+  * @brief     This section group all the functions that manage the tap and
+  *            double tap event generation
+  * @{
+  *
+  */
+
+/**
+  * @brief  Tap/Double Tap generator configuration register.[set]
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      registers CLICK_CFG
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3dh_tap_conf_set(const stmdev_ctx_t *ctx,
+                            lis3dh_click_cfg_t *val)
+{
+  int32_t ret;
+
+  ret = lis3dh_write_reg(ctx, LIS3DH_CLICK_CFG, (uint8_t *) val, 1);
+
+  return ret;
+}
+
+/**
+  * @brief  Tap/Double Tap generator configuration register.[get]
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      registers CLICK_CFG
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3dh_tap_conf_get(const stmdev_ctx_t *ctx,
+                            lis3dh_click_cfg_t *val)
+{
+  int32_t ret;
+
+  ret = lis3dh_read_reg(ctx, LIS3DH_CLICK_CFG, (uint8_t *) val, 1);
+
+  return ret;
+}
+/**
+  * @brief  Tap/Double Tap generator source register.[get]
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      registers CLICK_SRC
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3dh_tap_source_get(const stmdev_ctx_t *ctx,
+                              lis3dh_click_src_t *val)
+{
+  int32_t ret;
+
+  ret = lis3dh_read_reg(ctx, LIS3DH_CLICK_SRC, (uint8_t *) val, 1);
+
+  return ret;
+}
+/**
+  * @brief  User-defined threshold value for Tap/Double Tap event.[set]
   *         1 LSB = full scale/128
   *
   * @param  ctx      read / write interface definitions
-  * @param  val      change the values of ths in reg CLICK_THS
+  * @param  val      change the values of ths in reg CLICK_THS
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3dh_tap_threshold_set(const stmdev_ctx_t *ctx, uint8_t val)
+{
+  int32_t ret;
+
+  ret = lis3dh_field_set(ctx, LIS3DH_FIELD_CLICK_THS, val);
+
+  return ret;
+}
+
+/**
+  * @brief  User-defined threshold value for Tap/Double Tap event.[get]
+  *         1 LSB = full scale/128
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      change the values of ths in reg CLICK_THS
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3dh_tap_threshold_get(const stmdev_ctx_t *ctx, uint8_t *val)
+{
+  int32_t ret;
+
+  ret = lis3dh_field_get(ctx, LIS3DH_FIELD_CLICK_THS, val);
+
+  return ret;
+}
+
+/**
+  * @brief   If the LIR_Click bit is not set, the interrupt is kept high
+  *          for the duration of the latency window.
+  *          If the LIR_Click bit is set, the interrupt is kept high until the
+  *          CLICK_SRC(39h) register is read.[set]
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      change the values of lir_click in reg CLICK_THS
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3dh_tap_notification_mode_set(const stmdev_ctx_t *ctx,
+                                         lis3dh_lir_click_t val)
+{
+  int32_t ret;
+
+  ret = lis3dh_field_set(ctx, LIS3DH_FIELD_LIR_CLICK, (uint8_t)val);
+
+  return ret;
+}
+
+/**
+  * @brief   If the LIR_Click bit is not set, the interrupt is kept high
+  *          for the duration of the latency window.
+  *          If the LIR_Click bit is set, the interrupt is kept high until the
+  *          CLICK_SRC(39h) register is read.[get]
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      Get the values of lir_click in reg CLICK_THS
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3dh_tap_notification_mode_get(const stmdev_ctx_t *ctx,
+                                         lis3dh_lir_click_t *val)
+{
+  lis3dh_click_ths_t click_ths;
+  int32_t ret;
+
+  ret = lis3dh_read_reg(ctx, LIS3DH_CLICK_THS, (uint8_t *)&click_ths, 1);
+
+  if (ret != 0) { return ret; }
+
+  switch (click_ths.lir_click)
+  {
+    case 0x00:
+      *val = LIS3DH_TAP_PULSED;
+      break;
+
+    case 0x01:
+      *val = LIS3DH_TAP_LATCHED;
+      break;
+
+    default:
+      *val = LIS3DH_TAP_PULSED;
+      break;
+  }
+
+  return ret;
+}
+
+/**
+  * @brief  The maximum time (1 LSB = 1/ODR) interval that can elapse
+  *         between the start of the click-detection procedure and when the
+  *         acceleration falls back below the threshold.[set]
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      change the values of tli in reg TIME_LIMIT
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3dh_shock_dur_set(const stmdev_ctx_t *ctx, uint8_t val)
+{
+  int32_t ret;
+
+  ret = lis3dh_field_set(ctx, LIS3DH_FIELD_TLI, val);
+
+  return ret;
+}
+
+/**
+  * @brief  The maximum time (1 LSB = 1/ODR) interval that can elapse between
+  *         the start of the click-detection procedure and when the
+  *         acceleration falls back below the threshold.[get]
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      change the values of tli in reg TIME_LIMIT
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3dh_shock_dur_get(const stmdev_ctx_t *ctx, uint8_t *val)
+{
+  int32_t ret;
+
+  ret = lis3dh_field_get(ctx, LIS3DH_FIELD_TLI, val);
+
+  return ret;
+}
+
+/**
+  * @brief  The time (1 LSB = 1/ODR) interval that starts after the first
+  *         click detection where the click-detection procedure is
+  *         disabled, in cases where the device is configured for
+  *         double-click detection.[set]
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      change the values of tla in reg TIME_LATENCY
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3dh_quiet_dur_set(const stmdev_ctx_t *ctx, uint8_t val)
+{
+  int32_t ret;
+
+  ret = lis3dh_field_set(ctx, LIS3DH_FIELD_TLA, val);
+
+  return ret;
+}
+
+/**
+  * @brief  The time (1 LSB = 1/ODR) interval that starts after the first
+  *         click detection where the click-detection procedure is
+  *         disabled, in cases where the device is configured for
+  *         double-click detection.[get]
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      change the values of tla in reg TIME_LATENCY
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3dh_quiet_dur_get(const stmdev_ctx_t *ctx, uint8_t *val)
+{
+  int32_t ret;
+
+  ret = lis3dh_field_get(ctx, LIS3DH_FIELD_TLA, val);
+
+  return ret;
+}
+
+/**
+  * @brief  The maximum interval of time (1 LSB = 1/ODR) that can elapse
+  *         after the end of the latency interval in which the click-detection
+  *         procedure can start, in cases where the device is configured
+  *         for double-click detection.[set]
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      change the values of tw in reg TIME_WINDOW
   * @retval          interface status (MANDATORY: return 0 -> no Error)
   *
   */
-int32_t lis3dh_tap_threshold_get(const stmdev_ctx_t *ctx, uint8_t *val)
+int32_t lis3dh_double_tap_timeout_set(const stmdev_ctx_t *ctx, uint8_t val)
 {
-  lis3dh_click_ths_t click_ths;
   int32_t ret;
 
-  ret = lis3dh_read_reg(ctx, LIS3DH_CLICK_THS, (uint8_t *)&click_ths, 1);
+  ret = lis3dh_field_set(ctx, LIS3DH_FIELD_TW, val);
+
+  return ret;
+}
+
+/**
+  * @brief  The maximum interval of time (1 LSB = 1/ODR) that can elapse
+  *         after the end of the latency interval in which the
+  *         click-detection procedure can start, in cases where the device
+  *         is configured for double-click detection.[get]
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      change the values of tw in reg TIME_WINDOW
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3dh_double_tap_timeout_get(const stmdev_ctx_t *ctx, uint8_t *val)
+{
+  int32_t ret;
+
+  ret = lis3dh_field_get(ctx, LIS3DH_FIELD_TW, val);
+
+  return ret;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup  LIS3DH_Activity_inactivity
+  * @brief     This section group all the functions concerning activity
+  *            inactivity functionality
+  * @{
+  *
+  */
+
+/**
+  * @brief    Sleep-to-wake, return-to-sleep activation threshold in
+  *           low-power mode.[set]
+  *           1 LSb = 16mg@2g / 32mg@4g / 62mg@8g / 186mg@16g
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      change the values of acth in reg ACT_THS
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3dh_act_threshold_set(const stmdev_ctx_t *ctx, uint8_t val)
+{
+  int32_t ret;
+
+  ret = lis3dh_field_set(ctx, LIS3DH_FIELD_ACTH, val);
+
+  return ret;
+}
+
+/**
+  * @brief  Sleep-to-wake, return-to-sleep activation threshold in low-power
+  *         mode.[get]
+  *         1 LSb = 16mg@2g / 32mg@4g / 62mg@8g / 186mg@16g
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      change the values of acth in reg ACT_THS
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3dh_act_threshold_get(const stmdev_ctx_t *ctx, uint8_t *val)
+{
+  int32_t ret;
+
+  ret = lis3dh_field_get(ctx, LIS3DH_FIELD_ACTH, val);
+
+  return ret;
+}
+
+/**
+  * @brief  Sleep-to-wake, return-to-sleep.[set]
+  *         duration = (8*1[LSb]+1)/ODR
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      change the values of actd in reg ACT_DUR
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3dh_act_timeout_set(const stmdev_ctx_t *ctx, uint8_t val)
+{
+  int32_t ret;
+
+  ret = lis3dh_field_set(ctx, LIS3DH_FIELD_ACTD, val);
+
+  return ret;
+}
+
+/**
+  * @brief  Sleep-to-wake, return-to-sleep.[get]
+  *         duration = (8*1[LSb]+1)/ODR
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      change the values of actd in reg ACT_DUR
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3dh_act_timeout_get(const stmdev_ctx_t *ctx, uint8_t *val)
+{
+  int32_t ret;
+
+  ret = lis3dh_field_get(ctx, LIS3DH_FIELD_ACTD, val);
+
+  return ret;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup  LIS3DH_Serial_interface
+  * @brief     This section group all the functions concerning serial
+  *            interface management
+  * @{
+  *
+  */
+
+/**
+  * @brief  Connect/Disconnect SDO/SA0 internal pull-up.[set]
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      change the values of sdo_pu_disc in reg CTRL_REG0
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3dh_pin_sdo_sa0_mode_set(const stmdev_ctx_t *ctx,
+                                    lis3dh_sdo_pu_disc_t val)
+{
+  int32_t ret;
+
+  ret = lis3dh_field_set(ctx, LIS3DH_FIELD_SDO_PU_DISC, (uint8_t)val);
+
+  return ret;
+}
+
+/**
+  * @brief  Connect/Disconnect SDO/SA0 internal pull-up.[get]
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      Get the values of sdo_pu_disc in reg CTRL_REG0
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3dh_pin_sdo_sa0_mode_get(const stmdev_ctx_t *ctx,
+                                    lis3dh_sdo_pu_disc_t *val)
+{
+  lis3dh_ctrl_reg0_t ctrl_reg0;
+  int32_t ret;
+
+  ret = lis3dh_read_reg(ctx, LIS3DH_CTRL_REG0, (uint8_t *)&ctrl_reg0, 1);
 
   if (ret != 0) { return ret; }
 
-  *val = (uint8_t)click_ths.ths;
+  switch (ctrl_reg0.sdo_pu_disc)
+  {
+    case 0x01:
+      *val = LIS3DH_PULL_UP_DISCONNECT;
+      break;
+
+    case 0x00:
+      *val = LIS3DH_PULL_UP_CONNECT;
+      break;
+
+    default:
+      *val = LIS3DH_PULL_UP_DISCONNECT;
+      break;
+  }
 
   return ret;
 }
 
 /**
-  * @brief   If the LIR_Click bit is not set, the interrupt is kept high
-  *          for the duration of the latency window.
-  *          If the LIR_Click bit is set, the interrupt is kept high until the
-  *          CLICK_SRC(39h) register is read.[set]
+  * @brief  SPI Serial Interface Mode selection.[set]
   *
   * @param  ctx      read / write interface definitions
-  * @param  val      change the values of lir_click in reg CLICK_THS
+  * @param  val      change the values of sim in reg CTRL_REG4
   * @retval          interface status (MANDATORY: return 0 -> no Error)
   *
   */
-int32_t lis3dh_tap_notification_mode_set(const stmdev_ctx_t *ctx,
-                                         lis3dh_lir_click_t val)
+int32_t lis3dh_spi_mode_set(const stmdev_ctx_t *ctx, lis3dh_sim_t val)
 {
-  lis3dh_click_ths_t click_ths;
   int32_t ret;
 
-  ret = lis3dh_read_reg(ctx, LIS3DH_CLICK_THS, (uint8_t *)&click_ths, 1);
+  ret = lis3dh_field_set(ctx, LIS3DH_FIELD_SIM, (uint8_t)val);
+
+  return ret;
+}
+
+/**
+  * @brief  SPI Serial Interface Mode selection.[get]
+  *
+  * @param  ctx      read / write interface definitions
+  * @param  val      Get the values of sim in reg CTRL_REG4
+  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  *
+  */
+int32_t lis3dh_spi_mode_get(const stmdev_ctx_t *ctx, lis3dh_sim_t *val)
+{
+  lis3dh_ctrl_reg4_t ctrl_reg4;
+  int32_t ret;
+
+  ret = lis3dh_read_reg(ctx, LIS3DH_CTRL_REG4, (uint8_t *)&ctrl_reg4, 1);
+
+  if (ret != 0) { return ret; }
+
+  switch (ctrl_reg4.sim)
+  {
+    case 0x00:
+      *val = LIS3DH_SPI_4_WIRE;
+      break;
+
+    case 0x01:
+      *val = LIS3DH_SPI_3_WIRE;
+      break;
+
+    default:
+      *val = LIS3DH_SPI_4_WIRE;
+      break;
+  }
+
+  return ret;
+}
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup  LIS3DH_Configuration
+  * @brief     This section group the functions that read or write the
+  *            whole device configuration at once.
+  * @{
+  *
+  */
+
+/**
+  * @brief  Find the next block of contiguous configuration registers.
+  *
+  * @param  from     address where the search starts
+  * @param  first    first register of the block(ptr)
+  * @param  last     last register of the block(ptr)
+  * @retval          PROPERTY_ENABLE if a block has been found,
+  *                  PROPERTY_DISABLE if there is none up to ACT_DUR
+  *
+  */
+static uint8_t lis3dh_config_block_next(uint8_t from, uint8_t *first,
+                                        uint8_t *last)
+{
+  uint8_t addr = from;
+
+  while ((addr <= LIS3DH_ACT_DUR) &&
+         (lis3dh_is_config_reg(addr) == PROPERTY_DISABLE))
+  {
+    addr++;
+  }
+
+  if (addr > LIS3DH_ACT_DUR)
+  {
+    return PROPERTY_DISABLE;
+  }
 
-  if (ret == 0)
+  *first = addr;
+  while ((addr < LIS3DH_ACT_DUR) &&
+         (lis3dh_is_config_reg((uint8_t)(addr + 1U)) == PROPERTY_ENABLE))
   {
-    click_ths.lir_click = (uint8_t)val & 0x01U;
-    ret = lis3dh_write_reg(ctx, LIS3DH_CLICK_THS, (uint8_t *)&click_ths, 1);
+    addr++;
   }
+  *last = addr;
 
-  return ret;
+  return PROPERTY_ENABLE;
 }
 
 /**
-  * @brief   If the LIR_Click bit is not set, the interrupt is kept high
-  *          for the duration of the latency window.
-  *          If the LIR_Click bit is set, the interrupt is kept high until the
-  *          CLICK_SRC(39h) register is read.[get]
+  * @brief  Read all the configuration registers into img (indexed from
+  *         CTRL_REG0), one burst for each contiguous block.
   *
   * @param  ctx      read / write interface definitions
-  * @param  val      Get the values of lir_click in reg CLICK_THS
+  * @param  img      buffer of LIS3DH_CONFIG_SIZE bytes
   * @retval          interface status (MANDATORY: return 0 -> no Error)
   *
   */
-int32_t lis3dh_tap_notification_mode_get(const stmdev_ctx_t *ctx,
-                                         lis3dh_lir_click_t *val)
+static int32_t lis3dh_config_image_read(const stmdev_ctx_t *ctx,
+                                        uint8_t *img)
 {
-  lis3dh_click_ths_t click_ths;
-  int32_t ret;
-
-  ret = lis3dh_read_reg(ctx, LIS3DH_CLICK_THS, (uint8_t *)&click_ths, 1);
-
-  if (ret != 0) { return ret; }
+  uint8_t from = LIS3DH_CTRL_REG0;
+  uint8_t first;
+  uint8_t last;
+  uint8_t i;
+  int32_t ret = 0;
 
-  switch (click_ths.lir_click)
+  for (i = 0; i < LIS3DH_CONFIG_SIZE; i++)
   {
-    case 0x00:
-      *val = LIS3DH_TAP_PULSED;
-      break;
-
-    case 0x01:
-      *val = LIS3DH_TAP_LATCHED;
-      break;
+    img[i] = 0;
+  }
 
-    default:
-      *val = LIS3DH_TAP_PULSED;
-      break;
+  while ((ret == 0) &&
+         (lis3dh_config_block_next(from, &first, &last) == PROPERTY_ENABLE))
+  {
+    ret = lis3dh_read_reg(ctx, first, &img[first - LIS3DH_CTRL_REG0],
+                          (uint16_t)(last - first) + 1U);
+    from = (uint8_t)(last + 1U);
   }
 
   return ret;
 }
 
 /**
-  * @brief  The maximum time (1 LSB = 1/ODR) interval that can elapse
-  *         between the start of the click-detection procedure and when the
-  *         acceleration falls back below the threshold.[set]
+  * @brief  Write the registers first .. last of a configuration image in
+  *         a single burst; if cur is given, only the span from the first
+  *         to the last register that differs from it is written.
   *
   * @param  ctx      read / write interface definitions
-  * @param  val      change the values of tli in reg TIME_LIMIT
+  * @param  cur      image read from the device, or NULL
+  * @param  img      image to write, indexed from CTRL_REG0
+  * @param  first    first register of the block
+  * @param  last     last register of the block
   * @retval          interface status (MANDATORY: return 0 -> no Error)
   *
   */
-int32_t lis3dh_shock_dur_set(const stmdev_ctx_t *ctx, uint8_t val)
+static int32_t lis3dh_config_block_write(const stmdev_ctx_t *ctx,
+                                         const uint8_t *cur, uint8_t *img,
+                                         uint8_t first, uint8_t last)
 {
-  lis3dh_time_limit_t time_limit;
-  int32_t ret;
+  uint8_t lo = (uint8_t)(first - LIS3DH_CTRL_REG0);
+  uint8_t hi = (uint8_t)(last - LIS3DH_CTRL_REG0);
 
-  ret = lis3dh_read_reg(ctx, LIS3DH_TIME_LIMIT, (uint8_t *)&time_limit, 1);
-
-  if (ret == 0)
+  if (cur != NULL)
   {
-    time_limit.tli = val & 0x7FU;
-    ret = lis3dh_write_reg(ctx, LIS3DH_TIME_LIMIT, (uint8_t *)&time_limit, 1);
+    while ((lo <= hi) && (img[lo] == cur[lo]))
+    {
+      lo++;
+    }
+
+    if (lo > hi)
+    {
+      return 0;
+    }
+
+    while (img[hi] == cur[hi])
+    {
+      hi--;
+    }
   }
 
-  return ret;
+  return lis3dh_write_reg(ctx, (uint8_t)(lo + LIS3DH_CTRL_REG0), &img[lo],
+                          (uint16_t)(hi - lo) + 1U);
 }
 
 /**
-  * @brief  The maximum time (1 LSB = 1/ODR) interval that can elapse between
-  *         the start of the click-detection procedure and when the
-  *         acceleration falls back below the threshold.[get]
+  * @brief  Write a configuration image, one burst for each contiguous
+  *         block. CTRL_REG0 .. CTRL_REG6 are written last, so that ODR,
+  *         interrupt routing and FIFO_EN take effect once thresholds,
+  *         FIFO and click settings are in place.
   *
   * @param  ctx      read / write interface definitions
-  * @param  val      change the values of tli in reg TIME_LIMIT
+  * @param  cur      image read from the device, to write only what
+  *                  changed, or NULL to write every block in full
+  * @param  img      image to write, indexed from CTRL_REG0
   * @retval          interface status (MANDATORY: return 0 -> no Error)
   *
   */
-int32_t lis3dh_shock_dur_get(const stmdev_ctx_t *ctx, uint8_t *val)
+static int32_t lis3dh_config_image_write(const stmdev_ctx_t *ctx,
+                                         const uint8_t *cur, uint8_t *img)
 {
-  lis3dh_time_limit_t time_limit;
-  int32_t ret;
+  uint8_t from = (uint8_t)(LIS3DH_CTRL_REG6 + 1U);
+  uint8_t first;
+  uint8_t last;
+  int32_t ret = 0;
 
-  ret = lis3dh_read_reg(ctx, LIS3DH_TIME_LIMIT, (uint8_t *)&time_limit, 1);
+  while ((ret == 0) &&
+         (lis3dh_config_block_next(from, &first, &last) == PROPERTY_ENABLE))
+  {
+    ret = lis3dh_config_block_write(ctx, cur, img, first, last);
+    from = (uint8_t)(last + 1U);
+  }
 
   if (ret != 0) { return ret; }
 
-  *val = (uint8_t)time_limit.tli;
+  ret = lis3dh_config_block_write(ctx, cur, img, LIS3DH_CTRL_REG0,
+                                  LIS3DH_CTRL_REG6);
 
   return ret;
 }
 
 /**
-  * @brief  The time (1 LSB = 1/ODR) interval that starts after the first
-  *         click detection where the click-detection procedure is
-  *         disabled, in cases where the device is configured for
-  *         double-click detection.[set]
+  * @brief  Copy a configuration to / from its register image.
   *
-  * @param  ctx      read / write interface definitions
-  * @param  val      change the values of tla in reg TIME_LATENCY
-  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  * @param  cfg      configuration(ptr)
+  * @param  img      buffer of LIS3DH_CONFIG_SIZE bytes indexed from
+  *                  CTRL_REG0
+  * @param  to_img   PROPERTY_ENABLE: cfg -> img, PROPERTY_DISABLE: img -> cfg
   *
   */
-int32_t lis3dh_quiet_dur_set(const stmdev_ctx_t *ctx, uint8_t val)
+static void lis3dh_config_image_copy(lis3dh_config_t *cfg, uint8_t *img,
+                                     uint8_t to_img)
 {
-  lis3dh_time_latency_t time_latency;
-  int32_t ret;
-
-  ret = lis3dh_read_reg(ctx, LIS3DH_TIME_LATENCY,
-                        (uint8_t *)&time_latency, 1);
-
-  if (ret == 0)
+  uint8_t *reg[LIS3DH_CONFIG_SIZE] = { NULL };
+  uint8_t i;
+
+  reg[LIS3DH_CTRL_REG0 - LIS3DH_CTRL_REG0]     = (uint8_t *)&cfg->ctrl_reg0;
+  reg[LIS3DH_TEMP_CFG_REG - LIS3DH_CTRL_REG0]  = (uint8_t *)&cfg->temp_cfg_reg;
+  reg[LIS3DH_CTRL_REG1 - LIS3DH_CTRL_REG0]     = (uint8_t *)&cfg->ctrl_reg1;
+  reg[LIS3DH_CTRL_REG2 - LIS3DH_CTRL_REG0]     = (uint8_t *)&cfg->ctrl_reg2;
+  reg[LIS3DH_CTRL_REG3 - LIS3DH_CTRL_REG0]     = (uint8_t *)&cfg->ctrl_reg3;
+  reg[LIS3DH_CTRL_REG4 - LIS3DH_CTRL_REG0]     = (uint8_t *)&cfg->ctrl_reg4;
+  reg[LIS3DH_CTRL_REG5 - LIS3DH_CTRL_REG0]     = (uint8_t *)&cfg->ctrl_reg5;
+  reg[LIS3DH_CTRL_REG6 - LIS3DH_CTRL_REG0]     = (uint8_t *)&cfg->ctrl_reg6;
+  reg[LIS3DH_FIFO_CTRL_REG - LIS3DH_CTRL_REG0] = (uint8_t *)&cfg->fifo_ctrl_reg;
+  reg[LIS3DH_INT1_CFG - LIS3DH_CTRL_REG0]      = (uint8_t *)&cfg->int1_cfg;
+  reg[LIS3DH_INT1_THS - LIS3DH_CTRL_REG0]      = (uint8_t *)&cfg->int1_ths;
+  reg[LIS3DH_INT1_DURATION - LIS3DH_CTRL_REG0] = (uint8_t *)&cfg->int1_duration;
+  reg[LIS3DH_INT2_CFG - LIS3DH_CTRL_REG0]      = (uint8_t *)&cfg->int2_cfg;
+  reg[LIS3DH_INT2_THS - LIS3DH_CTRL_REG0]      = (uint8_t *)&cfg->int2_ths;
+  reg[LIS3DH_INT2_DURATION - LIS3DH_CTRL_REG0] = (uint8_t *)&cfg->int2_duration;
+  reg[LIS3DH_CLICK_CFG - LIS3DH_CTRL_REG0]     = (uint8_t *)&cfg->click_cfg;
+  reg[LIS3DH_CLICK_THS - LIS3DH_CTRL_REG0]     = (uint8_t *)&cfg->click_ths;
+  reg[LIS3DH_TIME_LIMIT - LIS3DH_CTRL_REG0]    = (uint8_t *)&cfg->time_limit;
+  reg[LIS3DH_TIME_LATENCY - LIS3DH_CTRL_REG0]  = (uint8_t *)&cfg->time_latency;
+  reg[LIS3DH_TIME_WINDOW - LIS3DH_CTRL_REG0]   = (uint8_t *)&cfg->time_window;
+  reg[LIS3DH_ACT_THS - LIS3DH_CTRL_REG0]       = (uint8_t *)&cfg->act_ths;
+  reg[LIS3DH_ACT_DUR - LIS3DH_CTRL_REG0]       = (uint8_t *)&cfg->act_dur;
+
+  for (i = 0; i < LIS3DH_CONFIG_SIZE; i++)
   {
-    time_latency.tla = val;
-    ret = lis3dh_write_reg(ctx, LIS3DH_TIME_LATENCY,
-                           (uint8_t *)&time_latency, 1);
-  }
+    if (reg[i] == NULL)
+    {
+      continue;
+    }
 
-  return ret;
+    if (to_img == PROPERTY_ENABLE)
+    {
+      img[i] = *reg[i];
+    }
+    else
+    {
+      *reg[i] = img[i];
+    }
+  }
 }
 
 /**
-  * @brief  The time (1 LSB = 1/ODR) interval that starts after the first
-  *         click detection where the click-detection procedure is
-  *         disabled, in cases where the device is configured for
-  *         double-click detection.[get]
+  * @brief  Device configuration.[get]
+  *         Read with one burst for each contiguous block of
+  *         configuration registers; source registers are skipped so
+  *         latched interrupts are not cleared.
   *
   * @param  ctx      read / write interface definitions
-  * @param  val      change the values of tla in reg TIME_LATENCY
+  * @param  val      configuration read from the device
   * @retval          interface status (MANDATORY: return 0 -> no Error)
   *
   */
-int32_t lis3dh_quiet_dur_get(const stmdev_ctx_t *ctx, uint8_t *val)
+int32_t lis3dh_config_get(const stmdev_ctx_t *ctx, lis3dh_config_t *val)
 {
-  lis3dh_time_latency_t time_latency;
+  uint8_t img[LIS3DH_CONFIG_SIZE];
   int32_t ret;
 
-  ret = lis3dh_read_reg(ctx, LIS3DH_TIME_LATENCY,
-                        (uint8_t *)&time_latency, 1);
+  ret = lis3dh_config_image_read(ctx, img);
 
   if (ret != 0) { return ret; }
 
-  *val = (uint8_t)time_latency.tla;
+  lis3dh_config_image_copy(val, img, PROPERTY_DISABLE);
 
   return ret;
 }
 
 /**
-  * @brief  The maximum interval of time (1 LSB = 1/ODR) that can elapse
-  *         after the end of the latency interval in which the click-detection
-  *         procedure can start, in cases where the device is configured
-  *         for double-click detection.[set]
+  * @brief  Device configuration.[set]
+  *         The requested configuration is compared with the one in the
+  *         device and, for each contiguous block of configuration
+  *         registers (1Eh-25h, 2Eh, 30h, 32h-34h, 36h-38h, 3Ah-3Fh),
+  *         only the span from the first to the last changed register is
+  *         written, in a single burst.
+  *         CTRL_REG0 .. CTRL_REG6 are written last, so that ODR,
+  *         interrupt routing and FIFO_EN take effect once thresholds,
+  *         FIFO and click settings are in place. Bits 6..0 of CTRL_REG0
+  *         are always written as 0010000b, as required.
   *
   * @param  ctx      read / write interface definitions
-  * @param  val      change the values of tw in reg TIME_WINDOW
+  * @param  val      configuration to apply
   * @retval          interface status (MANDATORY: return 0 -> no Error)
   *
   */
-int32_t lis3dh_double_tap_timeout_set(const stmdev_ctx_t *ctx, uint8_t val)
+int32_t lis3dh_config_apply(const stmdev_ctx_t *ctx,
+                            const lis3dh_config_t *val)
 {
-  lis3dh_time_window_t time_window;
+  lis3dh_config_t cfg = *val;
+  uint8_t cur[LIS3DH_CONFIG_SIZE];
+  uint8_t img[LIS3DH_CONFIG_SIZE];
   int32_t ret;
 
-  ret = lis3dh_read_reg(ctx, LIS3DH_TIME_WINDOW,
-                        (uint8_t *)&time_window, 1);
+  ret = lis3dh_config_image_read(ctx, cur);
 
-  if (ret == 0)
-  {
-    time_window.tw = val;
-    ret = lis3dh_write_reg(ctx, LIS3DH_TIME_WINDOW,
-                           (uint8_t *)&time_window, 1);
-  }
+  if (ret != 0) { return ret; }
+
+  lis3dh_config_image_copy(&cfg, img, PROPERTY_ENABLE);
+
+  img[0] = (uint8_t)((img[0] & 0x80U) | 0x10U);
+
+  ret = lis3dh_config_image_write(ctx, cur, img);
 
   return ret;
 }
 
 /**
-  * @brief  The maximum interval of time (1 LSB = 1/ODR) that can elapse
-  *         after the end of the latency interval in which the
-  *         click-detection procedure can start, in cases where the device
-  *         is configured for double-click detection.[get]
+  * @brief  Load a configuration given as address / data pairs (UCF).
+  *         All the lines are checked first and nothing is written if an
+  *         address is not a writable register (CTRL_REG0 .. ACT_DUR,
+  *         source and status registers excluded). Lines are then
+  *         written in order, with runs of consecutive addresses merged
+  *         in a single burst.
+  *         A constant ucf_line_t array is placed in ROM by the compiler,
+  *         so a build-time table can be passed directly.
   *
   * @param  ctx      read / write interface definitions
-  * @param  val      change the values of tw in reg TIME_WINDOW
+  * @param  lines    address / data pairs
+  * @param  n        number of lines
   * @retval          interface status (MANDATORY: return 0 -> no Error)
   *
   */
-int32_t lis3dh_double_tap_timeout_get(const stmdev_ctx_t *ctx, uint8_t *val)
+int32_t lis3dh_load_ucf(const stmdev_ctx_t *ctx, const ucf_line_t *lines,
+                        size_t n)
 {
-  lis3dh_time_window_t time_window;
-  int32_t ret;
+  uint8_t buff[LIS3DH_CONFIG_SIZE];
+  uint16_t len;
+  size_t i;
+  int32_t ret = 0;
 
-  ret = lis3dh_read_reg(ctx, LIS3DH_TIME_WINDOW,
-                        (uint8_t *)&time_window, 1);
-
-  if (ret != 0) { return ret; }
+  for (i = 0; i < n; i++)
+  {
+    if ((lis3dh_is_config_reg(lines[i].address) == PROPERTY_DISABLE) &&
+        (lines[i].address != LIS3DH_REFERENCE))
+    {
+      return -1;
+    }
+  }
 
-  *val = (uint8_t)time_window.tw;
+  i = 0;
+  while ((ret == 0) && (i < n))
+  {
+    len = 0;
+    do
+    {
+      buff[len] = lines[i + len].data;
+      len++;
+    } while (((i + len) < n) && (len < LIS3DH_CONFIG_SIZE) &&
+             (lines[i + len].address ==
+              (uint8_t)(lines[i].address + len)));
+
+    ret = lis3dh_write_reg(ctx, lines[i].address, buff, len);
+    i += len;
+  }
 
   return ret;
 }
@@ -2601,109 +3982,283 @@ int32_t lis3dh_double_tap_timeout_get(const stmdev_ctx_t *ctx, uint8_t *val)
   */
 
 /**
-  * @defgroup  LIS3DH_Activity_inactivity
-  * @brief     This section group all the functions concerning activity
-  *            inactivity functionality
+  * @defgroup  LIS3DH_Register_map
+  * @brief     This section group the register map description and the
+  *            functions that save / restore the whole device state.
   * @{
   *
   */
 
+/* sorted by address; CTRL_REG0 .. ACT_DUR, with no gaps, come last */
+static const lis3dh_reg_info_t lis3dh_reg_map[] =
+{
+  { LIS3DH_STATUS_REG_AUX, 0x00U, 0x00U, 0U },
+  { LIS3DH_OUT_ADC1_L,     0x00U, 0x00U, 0U },
+  { LIS3DH_OUT_ADC1_H,     0x00U, 0x00U, 0U },
+  { LIS3DH_OUT_ADC2_L,     0x00U, 0x00U, 0U },
+  { LIS3DH_OUT_ADC2_H,     0x00U, 0x00U, 0U },
+  { LIS3DH_OUT_ADC3_L,     0x00U, 0x00U, 0U },
+  { LIS3DH_OUT_ADC3_H,     0x00U, 0x00U, 0U },
+  { LIS3DH_WHO_AM_I,       LIS3DH_ID, 0x00U, 0U },
+  { LIS3DH_CTRL_REG0,      0x10U, 0x80U, 0U },
+  { LIS3DH_TEMP_CFG_REG,   0x00U, 0xC0U, 0U },
+  { LIS3DH_CTRL_REG1,      0x07U, 0xFFU, 0U },
+  { LIS3DH_CTRL_REG2,      0x00U, 0xFFU, 0U },
+  { LIS3DH_CTRL_REG3,      0x00U, 0xFEU, 0U },
+  { LIS3DH_CTRL_REG4,      0x00U, 0xFFU, 0U },
+  { LIS3DH_CTRL_REG5,      0x00U, 0xCFU, 0U },
+  { LIS3DH_CTRL_REG6,      0x00U, 0xFAU, 0U },
+  { LIS3DH_REFERENCE,      0x00U, 0xFFU, LIS3DH_REG_RD_CLR },
+  { LIS3DH_STATUS_REG,     0x00U, 0x00U, 0U },
+  { LIS3DH_OUT_X_L,        0x00U, 0x00U, LIS3DH_REG_RD_CLR },
+  { LIS3DH_OUT_X_H,        0x00U, 0x00U, LIS3DH_REG_RD_CLR },
+  { LIS3DH_OUT_Y_L,        0x00U, 0x00U, LIS3DH_REG_RD_CLR },
+  { LIS3DH_OUT_Y_H,        0x00U, 0x00U, LIS3DH_REG_RD_CLR },
+  { LIS3DH_OUT_Z_L,        0x00U, 0x00U, LIS3DH_REG_RD_CLR },
+  { LIS3DH_OUT_Z_H,        0x00U, 0x00U, LIS3DH_REG_RD_CLR },
+  { LIS3DH_FIFO_CTRL_REG,  0x00U, 0xFFU, 0U },
+  { LIS3DH_FIFO_SRC_REG,   0x00U, 0x00U, 0U },
+  { LIS3DH_INT1_CFG,       0x00U, 0xFFU, 0U },
+  { LIS3DH_INT1_SRC,       0x00U, 0x00U, LIS3DH_REG_RD_CLR },
+  { LIS3DH_INT1_THS,       0x00U, 0x7FU, 0U },
+  { LIS3DH_INT1_DURATION,  0x00U, 0x7FU, 0U },
+  { LIS3DH_INT2_CFG,       0x00U, 0xFFU, 0U },
+  { LIS3DH_INT2_SRC,       0x00U, 0x00U, LIS3DH_REG_RD_CLR },
+  { LIS3DH_INT2_THS,       0x00U, 0x7FU, 0U },
+  { LIS3DH_INT2_DURATION,  0x00U, 0x7FU, 0U },
+  { LIS3DH_CLICK_CFG,      0x00U, 0x3FU, 0U },
+  { LIS3DH_CLICK_SRC,      0x00U, 0x00U, LIS3DH_REG_RD_CLR },
+  { LIS3DH_CLICK_THS,      0x00U, 0xFFU, 0U },
+  { LIS3DH_TIME_LIMIT,     0x00U, 0x7FU, 0U },
+  { LIS3DH_TIME_LATENCY,   0x00U, 0xFFU, 0U },
+  { LIS3DH_TIME_WINDOW,    0x00U, 0xFFU, 0U },
+  { LIS3DH_ACT_THS,        0x00U, 0x7FU, 0U },
+  { LIS3DH_ACT_DUR,        0x00U, 0xFFU, 0U },
+};
+
+#define LIS3DH_REG_MAP_SIZE \
+  (sizeof(lis3dh_reg_map) / sizeof(lis3dh_reg_map[0]))
+
 /**
-  * @brief    Sleep-to-wake, return-to-sleep activation threshold in
-  *           low-power mode.[set]
-  *           1 LSb = 16mg@2g / 32mg@4g / 62mg@8g / 186mg@16g
+  * @brief  Register map, sorted by address.[get]
   *
-  * @param  ctx      read / write interface definitions
-  * @param  val      change the values of acth in reg ACT_THS
-  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  * @param  n        number of entries in the map(ptr)
+  * @retval          register map
   *
   */
-int32_t lis3dh_act_threshold_set(const stmdev_ctx_t *ctx, uint8_t val)
+const lis3dh_reg_info_t *lis3dh_reg_map_get(size_t *n)
 {
-  lis3dh_act_ths_t act_ths;
-  int32_t ret;
+  *n = LIS3DH_REG_MAP_SIZE;
 
-  ret = lis3dh_read_reg(ctx, LIS3DH_ACT_THS, (uint8_t *)&act_ths, 1);
+  return lis3dh_reg_map;
+}
 
-  if (ret == 0)
+/**
+  * @brief  Description of one register.[get]
+  *         CTRL_REG0 .. ACT_DUR are indexed directly.
+  *
+  * @param  address  register address
+  * @retval          register description, NULL if address is reserved
+  *
+  */
+const lis3dh_reg_info_t *lis3dh_reg_info_get(uint8_t address)
+{
+  size_t i;
+
+  if ((address >= LIS3DH_CTRL_REG0) && (address <= LIS3DH_ACT_DUR))
   {
-    act_ths.acth = val & 0x7FU;
-    ret = lis3dh_write_reg(ctx, LIS3DH_ACT_THS, (uint8_t *)&act_ths, 1);
+    i = (LIS3DH_REG_MAP_SIZE - LIS3DH_CONFIG_SIZE) +
+        (size_t)(address - LIS3DH_CTRL_REG0);
+
+    return &lis3dh_reg_map[i];
   }
 
-  return ret;
+  for (i = 0; i < (LIS3DH_REG_MAP_SIZE - LIS3DH_CONFIG_SIZE); i++)
+  {
+    if (lis3dh_reg_map[i].address == address)
+    {
+      return &lis3dh_reg_map[i];
+    }
+  }
+
+  return NULL;
 }
 
+#ifdef LIS3DH_REG_MAP_NAMES
+
+typedef struct
+{
+  uint8_t     address;
+  const char *name;
+} lis3dh_reg_name_t;
+
+static const lis3dh_reg_name_t lis3dh_reg_name[] =
+{
+  { LIS3DH_STATUS_REG_AUX, "STATUS_REG_AUX" },
+  { LIS3DH_OUT_ADC1_L,     "OUT_ADC1_L" },
+  { LIS3DH_OUT_ADC1_H,     "OUT_ADC1_H" },
+  { LIS3DH_OUT_ADC2_L,     "OUT_ADC2_L" },
+  { LIS3DH_OUT_ADC2_H,     "OUT_ADC2_H" },
+  { LIS3DH_OUT_ADC3_L,     "OUT_ADC3_L" },
+  { LIS3DH_OUT_ADC3_H,     "OUT_ADC3_H" },
+  { LIS3DH_WHO_AM_I,       "WHO_AM_I" },
+  { LIS3DH_CTRL_REG0,      "CTRL_REG0" },
+  { LIS3DH_TEMP_CFG_REG,   "TEMP_CFG_REG" },
+  { LIS3DH_CTRL_REG1,      "CTRL_REG1" },
+  { LIS3DH_CTRL_REG2,      "CTRL_REG2" },
+  { LIS3DH_CTRL_REG3,      "CTRL_REG3" },
+  { LIS3DH_CTRL_REG4,      "CTRL_REG4" },
+  { LIS3DH_CTRL_REG5,      "CTRL_REG5" },
+  { LIS3DH_CTRL_REG6,      "CTRL_REG6" },
+  { LIS3DH_REFERENCE,      "REFERENCE" },
+  { LIS3DH_STATUS_REG,     "STATUS_REG" },
+  { LIS3DH_OUT_X_L,        "OUT_X_L" },
+  { LIS3DH_OUT_X_H,        "OUT_X_H" },
+  { LIS3DH_OUT_Y_L,        "OUT_Y_L" },
+  { LIS3DH_OUT_Y_H,        "OUT_Y_H" },
+  { LIS3DH_OUT_Z_L,        "OUT_Z_L" },
+  { LIS3DH_OUT_Z_H,        "OUT_Z_H" },
+  { LIS3DH_FIFO_CTRL_REG,  "FIFO_CTRL_REG" },
+  { LIS3DH_FIFO_SRC_REG,   "FIFO_SRC_REG" },
+  { LIS3DH_INT1_CFG,       "INT1_CFG" },
+  { LIS3DH_INT1_SRC,       "INT1_SRC" },
+  { LIS3DH_INT1_THS,       "INT1_THS" },
+  { LIS3DH_INT1_DURATION,  "INT1_DURATION" },
+  { LIS3DH_INT2_CFG,       "INT2_CFG" },
+  { LIS3DH_INT2_SRC,       "INT2_SRC" },
+  { LIS3DH_INT2_THS,       "INT2_THS" },
+  { LIS3DH_INT2_DURATION,  "INT2_DURATION" },
+  { LIS3DH_CLICK_CFG,      "CLICK_CFG" },
+  { LIS3DH_CLICK_SRC,      "CLICK_SRC" },
+  { LIS3DH_CLICK_THS,      "CLICK_THS" },
+  { LIS3DH_TIME_LIMIT,     "TIME_LIMIT" },
+  { LIS3DH_TIME_LATENCY,   "TIME_LATENCY" },
+  { LIS3DH_TIME_WINDOW,    "TIME_WINDOW" },
+  { LIS3DH_ACT_THS,        "ACT_THS" },
+  { LIS3DH_ACT_DUR,        "ACT_DUR" },
+};
+
 /**
-  * @brief  Sleep-to-wake, return-to-sleep activation threshold in low-power
-  *         mode.[get]
-  *         1 LSb = 16mg@2g / 32mg@4g / 62mg@8g / 186mg@16g
+  * @brief  Name of one register, as in the datasheet.[get]
+  *         Built only with LIS3DH_REG_MAP_NAMES defined.
   *
-  * @param  ctx      read / write interface definitions
-  * @param  val      change the values of acth in reg ACT_THS
-  * @retval          interface status (MANDATORY: return 0 -> no Error)
+  * @param  address  register address
+  * @retval          register name, NULL if address is reserved
   *
   */
-int32_t lis3dh_act_threshold_get(const stmdev_ctx_t *ctx, uint8_t *val)
+const char *lis3dh_reg_name_get(uint8_t address)
 {
-  lis3dh_act_ths_t act_ths;
-  int32_t ret;
+  size_t i;
 
-  ret = lis3dh_read_reg(ctx, LIS3DH_ACT_THS, (uint8_t *)&act_ths, 1);
-
-  if (ret != 0) { return ret; }
-
-  *val = (uint8_t)act_ths.acth;
+  for (i = 0; i < (sizeof(lis3dh_reg_name) / sizeof(lis3dh_reg_name[0])); i++)
+  {
+    if (lis3dh_reg_name[i].address == address)
+    {
+      return lis3dh_reg_name[i].name;
+    }
+  }
 
-  return ret;
+  return NULL;
 }
 
+#endif /* LIS3DH_REG_MAP_NAMES */
+
 /**
-  * @brief  Sleep-to-wake, return-to-sleep.[set]
-  *         duration = (8*1[LSb]+1)/ODR
+  * @brief  Save the device state.[get]
+  *         All the configuration registers from CTRL_REG0 to ACT_DUR
+  *         are read. A burst is extended across registers that can be
+  *         read without side effects (FIFO_SRC_REG), and split only
+  *         where a read would clear a latched source or pop output
+  *         data, so the device state is not changed: 5 bursts in all.
+  *         REFERENCE is not read, because reading it resets the
+  *         high-pass filter, and lis3dh_restore leaves it untouched.
   *
   * @param  ctx      read / write interface definitions
-  * @param  val      change the values of actd in reg ACT_DUR
+  * @param  val      device state(ptr)
   * @retval          interface status (MANDATORY: return 0 -> no Error)
   *
   */
-int32_t lis3dh_act_timeout_set(const stmdev_ctx_t *ctx, uint8_t val)
+int32_t lis3dh_snapshot(const stmdev_ctx_t *ctx, lis3dh_snapshot_t *val)
 {
-  lis3dh_act_dur_t act_dur;
-  int32_t ret;
-
-  ret = lis3dh_read_reg(ctx, LIS3DH_ACT_DUR, (uint8_t *)&act_dur, 1);
+  uint8_t from = LIS3DH_SNAPSHOT_FIRST;
+  uint8_t first;
+  uint8_t last;
+  uint8_t next;
+  uint8_t end;
+  uint8_t addr;
+  int32_t ret = 0;
+
+  for (addr = LIS3DH_SNAPSHOT_FIRST; addr <= LIS3DH_SNAPSHOT_LAST; addr++)
+  {
+    val->reg[addr - LIS3DH_SNAPSHOT_FIRST] = lis3dh_reg_info_get(addr)->reset;
+  }
 
-  if (ret == 0)
+  while ((ret == 0) &&
+         (lis3dh_config_block_next(from, &first, &last) == PROPERTY_ENABLE))
   {
-    act_dur.actd = val;
-    ret = lis3dh_write_reg(ctx, LIS3DH_ACT_DUR, (uint8_t *)&act_dur, 1);
+    /* merge the next blocks while the registers in between are safe */
+    while (lis3dh_config_block_next((uint8_t)(last + 1U), &next, &end) ==
+           PROPERTY_ENABLE)
+    {
+      addr = (uint8_t)(last + 1U);
+      while ((addr < next) &&
+             ((lis3dh_reg_info_get(addr)->flags & LIS3DH_REG_RD_CLR) == 0U))
+      {
+        addr++;
+      }
+
+      if (addr != next)
+      {
+        break;
+      }
+
+      last = end;
+    }
+
+    ret = lis3dh_read_reg(ctx, first,
+                          &val->reg[first - LIS3DH_SNAPSHOT_FIRST],
+                          (uint16_t)(last - first) + 1U);
+    from = (uint8_t)(last + 1U);
   }
 
   return ret;
 }
 
 /**
-  * @brief  Sleep-to-wake, return-to-sleep.[get]
-  *         duration = (8*1[LSb]+1)/ODR
+  * @brief  Restore a device state saved with lis3dh_snapshot.[set]
+  *         Only the writable configuration registers are written, one
+  *         burst for each contiguous block (1Eh-25h, 2Eh, 30h, 32h-34h,
+  *         36h-38h, 3Ah-3Fh): 6 bursts in all. Status, output, source
+  *         registers and REFERENCE are not written.
+  *         CTRL_REG0 .. CTRL_REG6 are written last, so that interrupt
+  *         routing and ODR take effect once thresholds, FIFO and click
+  *         settings are in place. Bits that are not writable are
+  *         forced to their reset value (CTRL_REG0 bits 6..0 included)
+  *         and BOOT is never set.
   *
   * @param  ctx      read / write interface definitions
-  * @param  val      change the values of actd in reg ACT_DUR
+  * @param  val      device state(ptr)
   * @retval          interface status (MANDATORY: return 0 -> no Error)
   *
   */
-int32_t lis3dh_act_timeout_get(const stmdev_ctx_t *ctx, uint8_t *val)
+int32_t lis3dh_restore(const stmdev_ctx_t *ctx,
+                       const lis3dh_snapshot_t *val)
 {
-  lis3dh_act_dur_t act_dur;
-  int32_t ret;
+  const lis3dh_reg_info_t *info;
+  uint8_t img[LIS3DH_SNAPSHOT_SIZE];
+  uint8_t i;
 
-  ret = lis3dh_read_reg(ctx, LIS3DH_ACT_DUR, (uint8_t *)&act_dur, 1);
-
-  if (ret != 0) { return ret; }
+  for (i = 0; i < LIS3DH_SNAPSHOT_SIZE; i++)
+  {
+    info = lis3dh_reg_info_get((uint8_t)(LIS3DH_SNAPSHOT_FIRST + i));
+    img[i] = (uint8_t)((val->reg[i] & info->rw_mask) |
+                       (info->reset & (uint8_t)~info->rw_mask));
+  }
 
-  *val = (uint8_t)act_dur.actd;
+  /* BOOT would reload the trimming and wipe what is being restored */
+  img[LIS3DH_CTRL_REG5 - LIS3DH_SNAPSHOT_FIRST] &= 0x7FU;
 
-  return ret;
+  return lis3dh_config_image_write(ctx, NULL, img);
 }
 
 /**
@@ -2711,132 +4266,122 @@ int32_t lis3dh_act_timeout_get(const stmdev_ctx_t *ctx, uint8_t *val)
   *
   */
 
+#ifdef LIS3DH_SHADOW_CACHE
+
 /**
-  * @defgroup  LIS3DH_Serial_interface
-  * @brief     This section group all the functions concerning serial
-  *            interface management
+  * @defgroup  LIS3DH_Shadow_cache
+  * @brief     This section group all the functions concerning the
+  *            optional shadow copy of the configuration registers.
+  *            Once attached, the read part of every read-modify-write
+  *            is served from memory and costs no bus transaction.
   * @{
   *
   */
 
 /**
-  * @brief  Connect/Disconnect SDO/SA0 internal pull-up.[set]
+  * @brief  Attach an empty shadow cache to the interface.
+  *         The cache is stored in ctx->priv_data, which must not be
+  *         used for anything else while it is attached.
+  *         No bus access is done: registers are loaded on first read
+  *         or with lis3dh_cache_resync.
   *
   * @param  ctx      read / write interface definitions
-  * @param  val      change the values of sdo_pu_disc in reg CTRL_REG0
+  * @param  cache    cache storage, owned by the caller(ptr)
   * @retval          interface status (MANDATORY: return 0 -> no Error)
   *
   */
-int32_t lis3dh_pin_sdo_sa0_mode_set(const stmdev_ctx_t *ctx,
-                                    lis3dh_sdo_pu_disc_t val)
+int32_t lis3dh_cache_init(stmdev_ctx_t *ctx, lis3dh_cache_t *cache)
 {
-  lis3dh_ctrl_reg0_t ctrl_reg0;
-  int32_t ret;
+  uint8_t i;
 
-  ret = lis3dh_read_reg(ctx, LIS3DH_CTRL_REG0, (uint8_t *)&ctrl_reg0, 1);
+  if ((ctx == NULL) || (cache == NULL))
+  {
+    return -1;
+  }
 
-  if (ret == 0)
+  for (i = 0; i < LIS3DH_CACHE_SIZE; i++)
   {
-    ctrl_reg0.sdo_pu_disc = (uint8_t)val & 0x01U;
-    ret = lis3dh_write_reg(ctx, LIS3DH_CTRL_REG0, (uint8_t *)&ctrl_reg0, 1);
+    cache->reg[i] = 0;
   }
+  cache->valid = 0;
+  cache->hit = 0;
+  cache->miss = 0;
 
-  return ret;
+  ctx->priv_data = cache;
+
+  return 0;
 }
 
 /**
-  * @brief  Connect/Disconnect SDO/SA0 internal pull-up.[get]
+  * @brief  Drop the cached content, i.e. after a power cycle or any
+  *         access to the device done outside of this driver.
   *
   * @param  ctx      read / write interface definitions
-  * @param  val      Get the values of sdo_pu_disc in reg CTRL_REG0
   * @retval          interface status (MANDATORY: return 0 -> no Error)
   *
   */
-int32_t lis3dh_pin_sdo_sa0_mode_get(const stmdev_ctx_t *ctx,
-                                    lis3dh_sdo_pu_disc_t *val)
+int32_t lis3dh_cache_invalidate(const stmdev_ctx_t *ctx)
 {
-  lis3dh_ctrl_reg0_t ctrl_reg0;
-  int32_t ret;
-
-  ret = lis3dh_read_reg(ctx, LIS3DH_CTRL_REG0, (uint8_t *)&ctrl_reg0, 1);
+  lis3dh_cache_t *cache;
 
-  if (ret != 0) { return ret; }
-
-  switch (ctrl_reg0.sdo_pu_disc)
+  if ((ctx == NULL) || (ctx->priv_data == NULL))
   {
-    case 0x01:
-      *val = LIS3DH_PULL_UP_DISCONNECT;
-      break;
-
-    case 0x00:
-      *val = LIS3DH_PULL_UP_CONNECT;
-      break;
-
-    default:
-      *val = LIS3DH_PULL_UP_DISCONNECT;
-      break;
+    return -1;
   }
 
-  return ret;
+  cache = (lis3dh_cache_t *)ctx->priv_data;
+  cache->valid = 0;
+
+  return 0;
 }
 
 /**
-  * @brief  SPI Serial Interface Mode selection.[set]
+  * @brief  Reload the cache from the device with one burst read for each
+  *         contiguous block of cacheable registers.
   *
   * @param  ctx      read / write interface definitions
-  * @param  val      change the values of sim in reg CTRL_REG4
   * @retval          interface status (MANDATORY: return 0 -> no Error)
   *
   */
-int32_t lis3dh_spi_mode_set(const stmdev_ctx_t *ctx, lis3dh_sim_t val)
+int32_t lis3dh_cache_resync(const stmdev_ctx_t *ctx)
 {
-  lis3dh_ctrl_reg4_t ctrl_reg4;
+  uint8_t buff[LIS3DH_CONFIG_SIZE];
   int32_t ret;
 
-  ret = lis3dh_read_reg(ctx, LIS3DH_CTRL_REG4, (uint8_t *)&ctrl_reg4, 1);
+  ret = lis3dh_cache_invalidate(ctx);
 
   if (ret == 0)
   {
-    ctrl_reg4.sim = (uint8_t)val & 0x01U;
-    ret = lis3dh_write_reg(ctx, LIS3DH_CTRL_REG4, (uint8_t *)&ctrl_reg4, 1);
+    ret = lis3dh_config_image_read(ctx, buff);
   }
 
   return ret;
 }
 
 /**
-  * @brief  SPI Serial Interface Mode selection.[get]
+  * @brief  Cache hit / miss counters.[get]
   *
   * @param  ctx      read / write interface definitions
-  * @param  val      Get the values of sim in reg CTRL_REG4
+  * @param  hit      reads served from the cache
+  * @param  miss     cacheable reads that went to the bus
   * @retval          interface status (MANDATORY: return 0 -> no Error)
   *
   */
-int32_t lis3dh_spi_mode_get(const stmdev_ctx_t *ctx, lis3dh_sim_t *val)
+int32_t lis3dh_cache_stats_get(const stmdev_ctx_t *ctx, uint32_t *hit,
+                               uint32_t *miss)
 {
-  lis3dh_ctrl_reg4_t ctrl_reg4;
-  int32_t ret;
-
-  ret = lis3dh_read_reg(ctx, LIS3DH_CTRL_REG4, (uint8_t *)&ctrl_reg4, 1);
-
-  if (ret != 0) { return ret; }
+  const lis3dh_cache_t *cache;
 
-  switch (ctrl_reg4.sim)
+  if ((ctx == NULL) || (ctx->priv_data == NULL))
   {
-    case 0x00:
-      *val = LIS3DH_SPI_4_WIRE;
-      break;
-
-    case 0x01:
-      *val = LIS3DH_SPI_3_WIRE;
-      break;
-
-    default:
-      *val = LIS3DH_SPI_4_WIRE;
-      break;
+    return -1;
   }
 
-  return ret;
+  cache = (const lis3dh_cache_t *)ctx->priv_data;
+  *hit = cache->hit;
+  *miss = cache->miss;
+
+  return 0;
 }
 
 /**
@@ -2844,6 +4389,8 @@ int32_t lis3dh_spi_mode_get(const stmdev_ctx_t *ctx, lis3dh_sim_t *val)
   *
   */
 
+#endif /* LIS3DH_SHADOW_CACHE */
+
 /**
   * @}
   *
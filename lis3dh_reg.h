@@ -742,6 +742,12 @@ typedef union
  * pointers to read/write routines for backward compatibility.
  * The __weak directive allows the final application to overwrite
  * them with a custom implementation.
+ * Defining LIS3DH_BUS_READ and LIS3DH_BUS_WRITE (name of the platform
+ * read / write functions, same prototype of stmdev_read_ptr and
+ * stmdev_write_ptr) binds the bus at compile time instead: the function
+ * pointers in stmdev_ctx_t are not used, the routines are not __weak and
+ * the transaction can be inlined. LIS3DH_BUS_INCLUDE optionally names
+ * the header, included by lis3dh_reg.c, that defines those functions.
  */
 
 int32_t lis3dh_read_reg(const stmdev_ctx_t *ctx, uint8_t reg, uint8_t *data,
@@ -852,6 +858,15 @@ typedef enum
 int32_t lis3dh_full_scale_set(const stmdev_ctx_t *ctx, lis3dh_fs_t val);
 int32_t lis3dh_full_scale_get(const stmdev_ctx_t *ctx, lis3dh_fs_t *val);
 
+int32_t lis3dh_from_lsb_to_mg_batch(lis3dh_op_md_t mode, lis3dh_fs_t fs,
+                                    const int16_t *in, float_t *out,
+                                    size_t n);
+int32_t lis3dh_from_lsb_to_ug(lis3dh_op_md_t mode, lis3dh_fs_t fs,
+                              int16_t lsb, int32_t *ug);
+int32_t lis3dh_from_lsb_to_ug_batch(lis3dh_op_md_t mode, lis3dh_fs_t fs,
+                                    const int16_t *in, int32_t *out,
+                                    size_t n);
+
 int32_t lis3dh_block_data_update_set(const stmdev_ctx_t *ctx, uint8_t val);
 int32_t lis3dh_block_data_update_get(const stmdev_ctx_t *ctx, uint8_t *val);
 
@@ -864,6 +879,10 @@ int32_t lis3dh_xl_data_ovr_get(const stmdev_ctx_t *ctx, uint8_t *val);
 
 int32_t lis3dh_acceleration_raw_get(const stmdev_ctx_t *ctx, int16_t *val);
 
+int32_t lis3dh_status_and_accel_get(const stmdev_ctx_t *ctx,
+                                    lis3dh_status_reg_t *status,
+                                    int16_t *val);
+
 int32_t lis3dh_device_id_get(const stmdev_ctx_t *ctx, uint8_t *buff);
 
 typedef enum
@@ -1010,6 +1029,105 @@ int32_t lis3dh_fifo_ovr_flag_get(const stmdev_ctx_t *ctx, uint8_t *val);
 
 int32_t lis3dh_fifo_fth_flag_get(const stmdev_ctx_t *ctx, uint8_t *val);
 
+#define LIS3DH_FIFO_DEPTH           32U
+int32_t lis3dh_fifo_data_read(const stmdev_ctx_t *ctx, int16_t (*xyz)[3],
+                              uint8_t max, uint8_t *got);
+uint8_t lis3dh_fifo_level_decode(const lis3dh_fifo_src_reg_t *val);
+void lis3dh_fifo_data_decode(const uint8_t *buff, int16_t (*xyz)[3],
+                             uint8_t level);
+
+/**
+  * @defgroup LIS3DH_Fifo_watermark_control
+  * @brief    Adaptive FIFO watermark: trades wakeups for latency at run
+  *           time, between fth_min and fth_max.
+  * @{
+  *
+  */
+
+typedef struct
+{
+  uint8_t  fth;               /* watermark currently set in the device */
+  uint8_t  fth_min;
+  uint8_t  fth_max;           /* latency bound: fth_max / ODR seconds */
+  uint8_t  streak;            /* drains in a row with room to raise fth */
+  uint32_t wakeups;
+  uint32_t samples;
+  uint32_t overruns;
+} lis3dh_fifo_wtm_ctrl_t;
+int32_t lis3dh_fifo_wtm_ctrl_init(const stmdev_ctx_t *ctx,
+                                  lis3dh_fifo_wtm_ctrl_t *val,
+                                  uint8_t fth_min, uint8_t fth_max);
+int32_t lis3dh_fifo_wtm_ctrl_update(const stmdev_ctx_t *ctx,
+                                    lis3dh_fifo_wtm_ctrl_t *val,
+                                    uint8_t level, uint8_t ovr);
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup LIS3DH_Timestamp
+  * @brief    Per-sample timestamps of FIFO data, rebuilt from the host
+  *           time of each drain.
+  * @{
+  *
+  */
+
+int32_t lis3dh_data_rate_to_hz(lis3dh_odr_t odr, lis3dh_op_md_t mode,
+                               uint32_t *val);
+
+typedef struct
+{
+  uint64_t last;              /* [us] newest sample of the previous drain */
+  uint32_t period;            /* [us/256] estimated sample period */
+  uint8_t  valid;
+} lis3dh_fifo_ts_t;
+int32_t lis3dh_fifo_ts_init(lis3dh_fifo_ts_t *ts, uint32_t odr_hz);
+void lis3dh_fifo_ts_update(lis3dh_fifo_ts_t *ts, uint64_t now,
+                           uint8_t level, uint8_t ovr, uint64_t *stamp);
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup LIS3DH_Statistics
+  * @brief    Single-pass running statistics of raw samples, per axis.
+  * @{
+  *
+  */
+
+typedef struct
+{
+  uint32_t n;                 /* samples folded in */
+  int16_t  min[3];            /* [LSB] */
+  int16_t  max[3];            /* [LSB] */
+  int64_t  sum[3];            /* [LSB] */
+  uint64_t sum_sq[3];         /* [LSB^2] */
+} lis3dh_stats_t;
+void lis3dh_stats_init(lis3dh_stats_t *val);
+void lis3dh_stats_update(lis3dh_stats_t *val, int16_t (*xyz)[3],
+                         size_t n);
+void lis3dh_stats_merge(lis3dh_stats_t *val, const lis3dh_stats_t *src);
+
+typedef struct
+{
+  float_t mean[3];            /* [mg] */
+  float_t var[3];             /* [mg^2] */
+  float_t rms[3];             /* [mg] */
+  float_t peak[3];            /* [mg] largest absolute value */
+  float_t crest[3];           /* peak / rms */
+} lis3dh_stats_mg_t;
+int32_t lis3dh_stats_get(const lis3dh_stats_t *val, lis3dh_op_md_t mode,
+                         lis3dh_fs_t fs, lis3dh_stats_mg_t *out);
+
+/**
+  * @}
+  *
+  */
+
 int32_t lis3dh_tap_conf_set(const stmdev_ctx_t *ctx,
                             lis3dh_click_cfg_t *val);
 int32_t lis3dh_tap_conf_get(const stmdev_ctx_t *ctx,
@@ -1065,6 +1183,133 @@ typedef enum
 int32_t lis3dh_spi_mode_set(const stmdev_ctx_t *ctx, lis3dh_sim_t val);
 int32_t lis3dh_spi_mode_get(const stmdev_ctx_t *ctx, lis3dh_sim_t *val);
 
+/**
+  * @defgroup LIS3DH_Configuration
+  * @brief    Whole device configuration: all the read / write registers
+  *           from CTRL_REG0 (1Eh) to ACT_DUR (3Fh).
+  * @{
+  *
+  */
+
+#define LIS3DH_CONFIG_SIZE          ((LIS3DH_ACT_DUR - LIS3DH_CTRL_REG0) + 1U)
+
+typedef struct
+{
+  lis3dh_ctrl_reg0_t      ctrl_reg0;
+  lis3dh_temp_cfg_reg_t   temp_cfg_reg;
+  lis3dh_ctrl_reg1_t      ctrl_reg1;
+  lis3dh_ctrl_reg2_t      ctrl_reg2;
+  lis3dh_ctrl_reg3_t      ctrl_reg3;
+  lis3dh_ctrl_reg4_t      ctrl_reg4;
+  lis3dh_ctrl_reg5_t      ctrl_reg5;
+  lis3dh_ctrl_reg6_t      ctrl_reg6;
+  lis3dh_fifo_ctrl_reg_t  fifo_ctrl_reg;
+  lis3dh_int1_cfg_t       int1_cfg;
+  lis3dh_int1_ths_t       int1_ths;
+  lis3dh_int1_duration_t  int1_duration;
+  lis3dh_int2_cfg_t       int2_cfg;
+  lis3dh_int2_ths_t       int2_ths;
+  lis3dh_int2_duration_t  int2_duration;
+  lis3dh_click_cfg_t      click_cfg;
+  lis3dh_click_ths_t      click_ths;
+  lis3dh_time_limit_t     time_limit;
+  lis3dh_time_latency_t   time_latency;
+  lis3dh_time_window_t    time_window;
+  lis3dh_act_ths_t        act_ths;
+  lis3dh_act_dur_t        act_dur;
+} lis3dh_config_t;
+int32_t lis3dh_config_get(const stmdev_ctx_t *ctx, lis3dh_config_t *val);
+int32_t lis3dh_config_apply(const stmdev_ctx_t *ctx,
+                            const lis3dh_config_t *val);
+
+int32_t lis3dh_load_ucf(const stmdev_ctx_t *ctx, const ucf_line_t *lines,
+                        size_t n);
+
+/**
+  * @}
+  *
+  */
+
+/**
+  * @defgroup LIS3DH_Register_map
+  * @brief    Description of every register (address, reset value,
+  *           writable bits) and snapshot / restore of the whole window
+  *           from CTRL_REG0 (1Eh) to ACT_DUR (3Fh). Register names are
+  *           available with LIS3DH_REG_MAP_NAMES defined.
+  * @{
+  *
+  */
+
+#define LIS3DH_REG_RD_CLR           0x01U /* read changes device state */
+
+typedef struct
+{
+  uint8_t address;
+  uint8_t reset;                     /* value after power-up / boot */
+  uint8_t rw_mask;                   /* writable bits, 0 if read-only */
+  uint8_t flags;                     /* LIS3DH_REG_RD_CLR */
+} lis3dh_reg_info_t;
+const lis3dh_reg_info_t *lis3dh_reg_map_get(size_t *n);
+const lis3dh_reg_info_t *lis3dh_reg_info_get(uint8_t address);
+#ifdef LIS3DH_REG_MAP_NAMES
+const char *lis3dh_reg_name_get(uint8_t address);
+#endif /* LIS3DH_REG_MAP_NAMES */
+
+#define LIS3DH_SNAPSHOT_FIRST       LIS3DH_CTRL_REG0
+#define LIS3DH_SNAPSHOT_LAST        LIS3DH_ACT_DUR
+#define LIS3DH_SNAPSHOT_SIZE        LIS3DH_CONFIG_SIZE
+
+typedef struct
+{
+  uint8_t reg[LIS3DH_SNAPSHOT_SIZE]; /* indexed from CTRL_REG0 */
+} lis3dh_snapshot_t;
+int32_t lis3dh_snapshot(const stmdev_ctx_t *ctx, lis3dh_snapshot_t *val);
+int32_t lis3dh_restore(const stmdev_ctx_t *ctx,
+                       const lis3dh_snapshot_t *val);
+
+/**
+  * @}
+  *
+  */
+
+#ifdef LIS3DH_SHADOW_CACHE
+
+/**
+  * @defgroup LIS3DH_Shadow_cache
+  * @brief    Optional write-through copy of the configuration registers
+  *           from CTRL_REG0 (1Eh) to ACT_DUR (3Fh), attached to the
+  *           interface through the priv_data pointer of stmdev_ctx_t.
+  *           Status, output and source registers are never cached.
+  *           Build with LIS3DH_SHADOW_CACHE defined to enable it.
+  * @{
+  *
+  */
+
+#define LIS3DH_CACHE_FIRST          LIS3DH_CTRL_REG0
+#define LIS3DH_CACHE_LAST           LIS3DH_ACT_DUR
+#define LIS3DH_CACHE_SIZE           LIS3DH_CONFIG_SIZE
+
+typedef struct
+{
+  uint8_t  reg[LIS3DH_CACHE_SIZE];
+  uint64_t valid;             /* bit n set -> reg[n] mirrors the device */
+  uint32_t hit;
+  uint32_t miss;
+} lis3dh_cache_t;
+
+int32_t lis3dh_cache_init(stmdev_ctx_t *ctx, lis3dh_cache_t *cache);
+int32_t lis3dh_cache_invalidate(const stmdev_ctx_t *ctx);
+int32_t lis3dh_cache_resync(const stmdev_ctx_t *ctx);
+int32_t lis3dh_cache_stats_get(const stmdev_ctx_t *ctx, uint32_t *hit,
+                               uint32_t *miss);
+
+/**
+  * @}
+  *
+  */
+
+#endif /* LIS3DH_SHADOW_CACHE */
+
 /**
   * @}
   *